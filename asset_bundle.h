@@ -0,0 +1,137 @@
+// Packed asset bundle
+// One file holding pre-decoded textures (RGBA8 pixels, ready for glTexImage2D) and sounds
+// (16-bit PCM), written offline by asset_packer.cpp. At runtime the bundle is memory-mapped and
+// raw entries are handed to raylib as Images/Waves that point straight into the mapped pages,
+// so start-up does no PNG/MP3 decoding and no copying. Entries may instead be DEFLATE
+// compressed (raylib's CompressData) to trade a little CPU for a smaller file.
+//
+// Layout (little-endian): BundleHeader, entryCount x BundleEntry, then entry data, each
+// block aligned to BUNDLE_ALIGN bytes.
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "mapped_file.h"
+
+const char *const BUNDLE_DEFAULT_PATH = "assets.sqb"; // looked for next to the executables
+const uint32_t BUNDLE_VERSION = 1;
+const size_t BUNDLE_ALIGN = 64;
+const int BUNDLE_NAME_MAX = 48; // including the terminator
+
+enum BundleKind : uint32_t { BUNDLE_TEXTURE, BUNDLE_SOUND };
+enum BundleCodec : uint32_t { BUNDLE_RAW, BUNDLE_DEFLATE };
+
+struct BundleHeader {
+    char magic[4]; // "SQBN"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct BundleEntry {
+    char name[BUNDLE_NAME_MAX]; // file name the entry was packed from, e.g. "doll_front.png"
+    uint32_t kind;
+    uint32_t codec;
+    uint64_t offset;  // from the start of the file
+    uint64_t size;    // stored bytes
+    uint64_t rawSize; // bytes after decompression
+    int32_t a, b, c, d; // texture: width, height, pixel format, mipmaps
+                        // sound: frame count, sample rate, sample size, channels
+};
+
+static_assert(sizeof(BundleHeader) == 16, "bundle header layout");
+static_assert(sizeof(BundleEntry) == 96, "bundle entry layout");
+
+class AssetBundle {
+public:
+    // A bundle with any malformed entry is rejected whole and left closed
+    bool Open(const char *path) {
+        index.clear();
+        if (!file.Open(path) || file.Size() < sizeof(BundleHeader)) return Fail();
+        const BundleHeader *h = (const BundleHeader *)file.Data();
+        if (memcmp(h->magic, "SQBN", 4) != 0 || h->version != BUNDLE_VERSION) return Fail();
+        if (sizeof(BundleHeader) + (uint64_t)h->entryCount * sizeof(BundleEntry) > file.Size()) return Fail();
+
+        const BundleEntry *entries = (const BundleEntry *)(file.Data() + sizeof(BundleHeader));
+        for (uint32_t i = 0; i < h->entryCount; i++) {
+            const BundleEntry &e = entries[i];
+            if (e.offset > file.Size() || e.size > file.Size() - e.offset) return Fail();
+            if (e.name[BUNDLE_NAME_MAX - 1] != '\0' || !SizesMatch(e)) return Fail();
+            index[e.name] = &e;
+        }
+        return true;
+    }
+
+    bool IsOpen() const { return file.Size() > 0; }
+    size_t Count() const { return index.size(); }
+
+    const BundleEntry *Find(const std::string &name) const {
+        auto it = index.find(name);
+        return it == index.end() ? nullptr : it->second;
+    }
+
+    // The pixels of a raw entry are the mapped bytes themselves (owned = false: don't
+    // UnloadImage them); compressed entries are inflated into a new allocation (owned = true).
+    // Safe to call from any thread.
+    bool GetImage(const BundleEntry &e, Image &out, bool &owned) const {
+        if (e.kind != BUNDLE_TEXTURE) return false;
+        void *data = GetData(e, owned);
+        if (!data) return false;
+        out = {data, e.a, e.b, e.d, e.c};
+        return true;
+    }
+
+    bool GetWave(const BundleEntry &e, Wave &out, bool &owned) const {
+        if (e.kind != BUNDLE_SOUND) return false;
+        void *data = GetData(e, owned);
+        if (!data) return false;
+        out = {(unsigned int)e.a, (unsigned int)e.b, (unsigned int)e.c, (unsigned int)e.d, data};
+        return true;
+    }
+
+private:
+    bool Fail() {
+        index.clear();
+        file.Close();
+        return false;
+    }
+
+    // rawSize must be exactly what the declared dimensions need (raw entries are handed to
+    // raylib as is, so a short one would be read past its end)
+    static bool SizesMatch(const BundleEntry &e) {
+        uint64_t expected;
+        if (e.kind == BUNDLE_TEXTURE) {
+            if (e.a <= 0 || e.b <= 0 || e.c != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return false;
+            expected = (uint64_t)e.a * (uint64_t)e.b * 4;
+        } else if (e.kind == BUNDLE_SOUND) {
+            if (e.a <= 0 || e.d <= 0 || (e.c != 8 && e.c != 16 && e.c != 32)) return false;
+            expected = (uint64_t)e.a * (uint64_t)e.d * (uint64_t)e.c / 8;
+        } else {
+            return false;
+        }
+        if (e.rawSize != expected) return false;
+        if (e.codec == BUNDLE_RAW) return e.size == e.rawSize;
+        return e.codec == BUNDLE_DEFLATE && e.rawSize <= (uint64_t)INT32_MAX && e.size <= (uint64_t)INT32_MAX;
+    }
+
+    void *GetData(const BundleEntry &e, bool &owned) const {
+        const uint8_t *stored = file.Data() + e.offset;
+        if (e.codec == BUNDLE_RAW) {
+            owned = false;
+            return (void *)stored; // raylib only reads it
+        }
+        int rawSize = 0;
+        unsigned char *raw = DecompressData(stored, (int)e.size, &rawSize);
+        if (raw && (uint64_t)rawSize != e.rawSize) {
+            MemFree(raw);
+            raw = nullptr;
+        }
+        owned = true;
+        return raw;
+    }
+
+    MappedReadFile file;
+    std::unordered_map<std::string, const BundleEntry *> index;
+};
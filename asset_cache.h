@@ -0,0 +1,307 @@
+// Shared asset cache
+// Textures and sounds keyed by file path: each file is decoded once, handed out with a
+// reference count and kept until Trim() or UnloadAll(). Preload*() queues the PNG/MP3 decode
+// (LoadImage / LoadWave, CPU only) on background threads; Poll() uploads finished decodes to
+// the GPU / audio device on the main thread, a few per frame. Acquire*() only blocks if the
+// asset was never preloaded or its decode hasn't finished yet.
+// With a bundle attached (asset_bundle.h) files found in it skip decoding entirely: the
+// upload reads the pre-decoded pixels/samples straight from the mapped bundle.
+// Images named in PreloadAtlas() are decoded the same way but packed together into one atlas
+// texture (sprite_atlas.h); AcquireSprite() hands out their rectangles of it.
+#pragma once
+#include <raylib.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "asset_bundle.h"
+#include "sprite_atlas.h"
+#include "frame_profiler.h"
+
+class AssetCache {
+public:
+    // decodeThreads <= 0 uses one per hardware core, leaving one for the main thread
+    explicit AssetCache(int decodeThreads = 0) {
+        if (decodeThreads <= 0) decodeThreads = (int)std::max(2u, std::thread::hardware_concurrency()) - 1;
+        for (int i = 0; i < decodeThreads; i++) workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    // GPU and audio resources must be released with UnloadAll() before CloseWindow()
+    ~AssetCache() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work.notify_all();
+        for (auto &t : workers) t.join();
+        for (auto &kv : entries) {
+            if (kv.second->state == DECODED || kv.second->kind == KIND_IMAGE) FreeDecoded(*kv.second);
+        }
+    }
+
+    AssetCache(const AssetCache &) = delete;
+    AssetCache &operator=(const AssetCache &) = delete;
+
+    // Serve files packed in bundle from it; call before preloading. The bundle must outlive
+    // the cache.
+    void SetBundle(const AssetBundle *packed) { bundle = packed; }
+
+    void PreloadTexture(const std::string &path) { Find(path, KIND_TEXTURE); }
+    void PreloadSound(const std::string &path) { Find(path, KIND_SOUND); }
+
+    // Decode these files in the background and pack them into the atlas once all are done
+    void PreloadAtlas(const std::vector<std::string> &paths) {
+        for (const std::string &path : paths) {
+            Find(path, KIND_IMAGE).refs++; // held until packed
+            atlasWaiting.push_back(path);
+        }
+    }
+
+    // A generated image to pack with them, found by name
+    void AddToAtlas(const std::string &name, const Image &img) { atlas.Add(name, img); }
+
+    // Main thread, once per frame: move up to maxUploads decoded assets onto the GPU, and build
+    // the atlas once every image for it has been decoded
+    void Poll(int maxUploads = 4) {
+        if (!atlasWaiting.empty()) {
+            bool decodedAll = true;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const std::string &path : atlasWaiting) {
+                    State st = entries.at(path)->state;
+                    decodedAll = decodedAll && (st == READY || st == FAILED);
+                }
+            }
+            if (decodedAll) BuildAtlas();
+        }
+        for (auto &kv : entries) {
+            if (maxUploads <= 0) break;
+            Entry &e = *kv.second;
+            bool decoded;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                decoded = e.state == DECODED;
+            }
+            if (decoded) {
+                Upload(e);
+                maxUploads--;
+            }
+        }
+    }
+
+    // True once nothing is waiting to be decoded or uploaded
+    bool Idle() const {
+        if (!atlasWaiting.empty()) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &kv : entries)
+            if (kv.second->state != READY && kv.second->state != FAILED) return false;
+        return true;
+    }
+
+    // A texture with id 0 (or a sound with frameCount 0) means the file failed to load
+    Texture2D AcquireTexture(const std::string &path) {
+        Entry &e = Ready(path, KIND_TEXTURE);
+        e.refs++;
+        return e.texture;
+    }
+
+    Sound AcquireSound(const std::string &path) {
+        Entry &e = Ready(path, KIND_SOUND);
+        e.refs++;
+        return e.sound;
+    }
+
+    // From the atlas when the file (or generated image) was packed into it, otherwise a whole
+    // texture acquired as above. An invalid sprite means the file failed to load.
+    Sprite AcquireSprite(const std::string &path) {
+        if (!atlasWaiting.empty() || atlas.HasPending()) BuildAtlas();
+        Sprite sprite = atlas.Find(path);
+        if (sprite.Valid()) return sprite;
+        return SpriteOf(AcquireTexture(path));
+    }
+
+    // Atlas sprites aren't reference counted: they stay until UnloadAll(), even across a
+    // rebuild, so releasing one is a no-op. Release them anyway to keep acquires paired.
+    void Release(const std::string &path) {
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second->refs > 0) it->second->refs--;
+    }
+
+    // Unload every loaded asset nobody holds
+    void Trim() {
+        for (auto it = entries.begin(); it != entries.end();) {
+            Entry &e = *it->second;
+            if (e.refs == 0 && (e.state == READY || e.state == FAILED)) {
+                Unload(e);
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Unload everything that has reached the GPU, held or not
+    void UnloadAll() {
+        atlas.Unload();
+        for (auto it = entries.begin(); it != entries.end();) {
+            Entry &e = *it->second;
+            if (e.state == READY || e.state == FAILED) {
+                Unload(e);
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    enum Kind { KIND_TEXTURE, KIND_SOUND, KIND_IMAGE }; // images stay on the CPU, for the atlas
+    enum State { QUEUED, DECODING, DECODED, READY, FAILED };
+
+    struct Entry {
+        std::string path;
+        Kind kind;
+        State state = QUEUED;
+        int refs = 0;
+        bool owned = true; // image/wave data must be freed (false: it lives in the bundle)
+        Image image = {};
+        Wave wave = {};
+        Texture2D texture = {};
+        Sound sound = {};
+    };
+
+    // Look up or create (and queue) the entry for path. Main thread only.
+    Entry &Find(const std::string &path, Kind kind) {
+        auto it = entries.find(path);
+        if (it != entries.end()) return *it->second;
+        auto entry = std::make_unique<Entry>();
+        entry->path = path;
+        entry->kind = kind;
+        Entry &e = *entry;
+        entries.emplace(path, std::move(entry));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(&e);
+        }
+        work.notify_one();
+        return e;
+    }
+
+    // Make sure the entry is uploaded, decoding it here if no worker has picked it up yet
+    Entry &Ready(const std::string &path, Kind kind) {
+        PROFILE_SCOPE("asset acquire");
+        Entry &e = Find(path, kind);
+        std::unique_lock<std::mutex> lock(mutex);
+        if (e.state == QUEUED) {
+            queue.erase(std::find(queue.begin(), queue.end(), &e));
+            e.state = DECODING;
+            lock.unlock();
+            Decode(e);
+            lock.lock();
+            e.state = Decoded(e);
+        }
+        decoded.wait(lock, [&] { return e.state != DECODING; });
+        lock.unlock();
+        if (e.state == DECODED) Upload(e);
+        return e;
+    }
+
+    void Decode(Entry &e) const {
+        const BundleEntry *packed = bundle ? bundle->Find(e.path) : nullptr;
+        if (packed) {
+            bool ok = e.kind != KIND_SOUND ? bundle->GetImage(*packed, e.image, e.owned)
+                                           : bundle->GetWave(*packed, e.wave, e.owned);
+            if (ok) return;
+        }
+        e.owned = true;
+        if (e.kind != KIND_SOUND) e.image = LoadImage(e.path.c_str());
+        else e.wave = LoadWave(e.path.c_str());
+    }
+
+    // State after decoding: images are done, textures and sounds still need uploading
+    static State Decoded(const Entry &e) {
+        if (e.kind != KIND_IMAGE) return DECODED;
+        return e.image.data ? READY : FAILED;
+    }
+
+    static void FreeDecoded(Entry &e) {
+        if (e.owned && e.image.data) UnloadImage(e.image);
+        if (e.owned && e.wave.data) UnloadWave(e.wave);
+        e.image = {};
+        e.wave = {};
+    }
+
+    // Main thread: create the GPU texture / audio buffer and drop the decoded copy
+    void Upload(Entry &e) {
+        PROFILE_SCOPE("asset upload");
+        bool ok = false;
+        if (e.kind == KIND_TEXTURE && e.image.data) {
+            e.texture = LoadTextureFromImage(e.image);
+            ok = e.texture.id != 0;
+        } else if (e.kind == KIND_SOUND && e.wave.data) {
+            e.sound = LoadSoundFromWave(e.wave);
+            ok = e.sound.frameCount != 0;
+        }
+        FreeDecoded(e);
+        std::lock_guard<std::mutex> lock(mutex);
+        e.state = ok ? READY : FAILED;
+    }
+
+    static void Unload(Entry &e) {
+        if (e.kind == KIND_IMAGE) FreeDecoded(e);
+        if (e.texture.id != 0) UnloadTexture(e.texture);
+        if (e.sound.frameCount != 0) UnloadSound(e.sound);
+        e.texture = {};
+        e.sound = {};
+    }
+
+    // Main thread: pack the waiting images (decoding any a worker hasn't reached) and drop their
+    // CPU copies. If they don't fit, AcquireSprite falls back to separate textures.
+    void BuildAtlas() {
+        for (const std::string &path : atlasWaiting) {
+            Entry &e = Ready(path, KIND_IMAGE);
+            if (e.image.data) atlas.Add(path, e.image);
+            Unload(e);
+            entries.erase(path);
+        }
+        atlasWaiting.clear();
+        if (atlas.HasPending() && !atlas.Build()) printf("Sprite atlas too large, drawing from separate textures\n");
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            Entry *e;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (stopping) return;
+                e = queue.front();
+                queue.pop_front();
+                e->state = DECODING;
+            }
+            Decode(*e);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                e->state = Decoded(*e);
+            }
+            decoded.notify_all();
+        }
+    }
+
+    const AssetBundle *bundle = nullptr;
+    SpriteAtlas atlas;
+    std::vector<std::string> atlasWaiting; // PreloadAtlas files not packed yet
+    std::unordered_map<std::string, std::unique_ptr<Entry>> entries; // main thread only
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex; // guards queue and Entry::state/image/wave hand-off
+    std::condition_variable work;
+    std::condition_variable decoded;
+    std::deque<Entry *> queue;
+    bool stopping = false;
+};
@@ -0,0 +1,169 @@
+// Offline asset packer
+// Decodes PNG/MP3 files once and writes them into a bundle (asset_bundle.h) that the games
+// memory-map at start-up instead of decoding the loose files.
+//
+//   g++ -std=c++17 -O2 asset_packer.cpp -o asset_packer -lraylib
+//   ./asset_packer assets.sqb *.png *.mp3
+//   ./asset_packer --compress assets.sqb *.png *.mp3
+//   ./asset_packer --root assets assets.sqb assets/*.png assets/*.mp3
+// Entries are named as the games look files up: relative to the directory they run in.
+#include <raylib.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "asset_bundle.h"
+
+static void Usage(const char *exe) {
+    printf("Usage: %s [--compress] [--root DIR] OUTPUT.sqb FILE...\n"
+           "  Textures (.png .jpg .bmp) are stored as RGBA8, sounds (.mp3 .wav .ogg) as 16-bit PCM.\n"
+           "  --compress stores an entry DEFLATE-compressed when that makes it smaller.\n"
+           "  --root DIR names each FILE relative to DIR, the directory the games run in (default: .).\n",
+           exe);
+}
+
+// The name the games will ask the cache for: path relative to root, without leading "./"
+static std::string EntryName(const char *path, const std::string &root) {
+    auto stripDot = [](std::string s) {
+        while (s.compare(0, 2, "./") == 0) s.erase(0, 2);
+        return s;
+    };
+    std::string name = stripDot(path);
+    std::string prefix = stripDot(root);
+    if (!prefix.empty() && prefix != ".") {
+        if (prefix.back() != '/') prefix += '/';
+        if (name.compare(0, prefix.size(), prefix) == 0) name = stripDot(name.substr(prefix.size()));
+    }
+    return name;
+}
+
+int main(int argc, char **argv) {
+    bool compress = false;
+    std::string root;
+    int arg = 1;
+    for (; arg < argc && !strncmp(argv[arg], "--", 2); arg++) {
+        if (!strcmp(argv[arg], "--compress")) compress = true;
+        else if (!strcmp(argv[arg], "--root") && arg + 1 < argc) root = argv[++arg];
+        else {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc - arg < 2) {
+        Usage(argv[0]);
+        return 1;
+    }
+    const char *outPath = argv[arg++];
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::vector<BundleEntry> entries;
+    std::vector<std::vector<unsigned char>> blobs;
+    for (; arg < argc; arg++) {
+        const char *path = argv[arg];
+        std::string name = EntryName(path, root);
+        if (name.size() >= (size_t)BUNDLE_NAME_MAX) {
+            printf("Skipping %s: name longer than %d characters\n", name.c_str(), BUNDLE_NAME_MAX - 1);
+            continue;
+        }
+        if (name.find('/') != std::string::npos)
+            printf("Warning: %s is stored as \"%s\"; the games look files up by their plain name "
+                   "(pack from the asset directory or pass --root)\n", path, name.c_str());
+
+        BundleEntry e = {};
+        memcpy(e.name, name.c_str(), name.size() + 1);
+        const unsigned char *raw = nullptr;
+        size_t rawSize = 0;
+        Image image = {};
+        Wave wave = {};
+
+        if (IsFileExtension(path, ".png;.jpg;.bmp")) {
+            image = LoadImage(path);
+            if (!image.data) {
+                printf("Skipping %s: could not decode\n", path);
+                continue;
+            }
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            e.kind = BUNDLE_TEXTURE;
+            e.a = image.width;
+            e.b = image.height;
+            e.c = image.format;
+            e.d = 1;
+            raw = (const unsigned char *)image.data;
+            rawSize = (size_t)image.width * image.height * 4;
+        } else if (IsFileExtension(path, ".mp3;.wav;.ogg")) {
+            wave = LoadWave(path);
+            if (!wave.data) {
+                printf("Skipping %s: could not decode\n", path);
+                continue;
+            }
+            WaveFormat(&wave, wave.sampleRate, 16, wave.channels);
+            e.kind = BUNDLE_SOUND;
+            e.a = (int32_t)wave.frameCount;
+            e.b = (int32_t)wave.sampleRate;
+            e.c = (int32_t)wave.sampleSize;
+            e.d = (int32_t)wave.channels;
+            raw = (const unsigned char *)wave.data;
+            rawSize = (size_t)wave.frameCount * wave.channels * 2;
+        } else {
+            printf("Skipping %s: unknown file type\n", path);
+            continue;
+        }
+
+        std::vector<unsigned char> blob;
+        e.codec = BUNDLE_RAW;
+        e.rawSize = rawSize;
+        if (compress) {
+            int compSize = 0;
+            unsigned char *comp = CompressData(raw, (int)rawSize, &compSize);
+            if (comp && (size_t)compSize < rawSize) {
+                e.codec = BUNDLE_DEFLATE;
+                blob.assign(comp, comp + compSize);
+            }
+            if (comp) MemFree(comp);
+        }
+        if (e.codec == BUNDLE_RAW) blob.assign(raw, raw + rawSize);
+        e.size = blob.size();
+
+        if (image.data) UnloadImage(image);
+        if (wave.data) UnloadWave(wave);
+
+        printf("%-24s %-7s %9zu -> %9zu bytes\n", e.name, e.kind == BUNDLE_TEXTURE ? "texture" : "sound",
+               rawSize, (size_t)e.size);
+        entries.push_back(e);
+        blobs.push_back(std::move(blob));
+    }
+
+    // Lay out the data blocks after the table
+    uint64_t offset = sizeof(BundleHeader) + entries.size() * sizeof(BundleEntry);
+    for (auto &e : entries) {
+        offset = (offset + BUNDLE_ALIGN - 1) / BUNDLE_ALIGN * BUNDLE_ALIGN;
+        e.offset = offset;
+        offset += e.size;
+    }
+
+    FILE *out = fopen(outPath, "wb");
+    if (!out) {
+        printf("Cannot write %s\n", outPath);
+        return 1;
+    }
+    BundleHeader header = {{'S', 'Q', 'B', 'N'}, BUNDLE_VERSION, (uint32_t)entries.size(), 0};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fwrite(entries.data(), sizeof(BundleEntry), entries.size(), out) == entries.size();
+    static const unsigned char zeros[BUNDLE_ALIGN] = {};
+    uint64_t written = sizeof(BundleHeader) + entries.size() * sizeof(BundleEntry);
+    for (size_t i = 0; i < entries.size() && ok; i++) {
+        size_t pad = (size_t)(entries[i].offset - written);
+        ok = fwrite(zeros, 1, pad, out) == pad && fwrite(blobs[i].data(), 1, blobs[i].size(), out) == blobs[i].size();
+        written = entries[i].offset + entries[i].size;
+    }
+    ok = fclose(out) == 0 && ok;
+    if (!ok) {
+        perror(outPath);
+        printf("Failed writing %s; removed the partial bundle\n", outPath);
+        remove(outPath);
+        return 1;
+    }
+
+    printf("Wrote %zu entries, %llu bytes to %s\n", entries.size(), (unsigned long long)written, outPath);
+    return 0;
+}
@@ -0,0 +1,277 @@
+// Glass bridge engine
+// The bridge's rules with no drawing. A layout is two bitsets with one bit per row: bit r of
+// safe[0] / safe[1] is set when the left / right panel of row r holds. A crossing is the row
+// reached plus two more bitsets for the panels stepped on. BridgeScene plays one crossing on
+// top of this.
+//
+// SimulateBridgeBatch plays millions of groups crossing in order, the way the show runs it.
+// Each player follows the panels already proven safe, guesses at the first unknown row, and
+// the next player avoids a panel that broke. Groups are bit-sliced: bit i of every word
+// belongs to group i, so one bitwise op applies a rule to 64 groups. Each group's death count
+// is a column of bits across "planes" and is summed with a ripple-carry adder on whole words.
+// The per-row loop over a block of words is plain array code the compiler vectorizes, and
+// blocks are spread over a TickScheduler.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "sim_random.h"
+#include "tick_scheduler.h"
+#include "tiled_bitset.h" // PopCount64
+
+const int BRIDGE_DEFAULT_ROWS = 5;
+
+enum BridgeRule {
+    BRIDGE_COIN_FLIP, // every panel holds with probability 1/2 (the game's rule; a row can be all broken)
+    BRIDGE_ONE_SAFE   // exactly one panel per row holds (the show's rule)
+};
+
+// One bit per row
+struct RowBits {
+    std::vector<uint64_t> words;
+
+    void Resize(int rows) { words.assign((rows + 63) / 64, 0); }
+    bool Get(int row) const { return (words[row >> 6] >> (row & 63)) & 1; }
+    void Set(int row, bool v) {
+        uint64_t bit = 1ULL << (row & 63);
+        if (v) words[row >> 6] |= bit;
+        else words[row >> 6] &= ~bit;
+    }
+    void Clear() { std::fill(words.begin(), words.end(), 0); }
+};
+
+struct BridgeLayout {
+    int rows = 0;
+    RowBits safe[2]; // [0] left, [1] right
+
+    void Resize(int rowCount) {
+        rows = rowCount;
+        safe[0].Resize(rowCount);
+        safe[1].Resize(rowCount);
+    }
+    bool Safe(int row, int side) const { return safe[side].Get(row); }
+};
+
+// Draws row by row, left panel then right, so the coin-flip rule consumes the stream exactly
+// like the original per-panel loop did (recorded replays stay valid)
+static inline void GenerateBridge(BridgeLayout &layout, int rows, BridgeRule rule, Pcg32 &rng) {
+    layout.Resize(rows);
+    for (int r = 0; r < rows; r++) {
+        if (rule == BRIDGE_ONE_SAFE) {
+            bool left = rng.Range(2) == 0;
+            layout.safe[0].Set(r, left);
+            layout.safe[1].Set(r, !left);
+        } else {
+            layout.safe[0].Set(r, rng.Range(2) == 0);
+            layout.safe[1].Set(r, rng.Range(2) == 0);
+        }
+    }
+}
+
+// ---------------------------
+// One crossing
+// ---------------------------
+
+enum BridgeStep { STEP_HELD, STEP_BROKE, STEP_CROSSED };
+
+struct BridgeCrossing {
+    int row = 0; // next row to step on
+    RowBits stepped[2];
+    bool over = false;
+    bool won = false;
+
+    void Reset(const BridgeLayout &layout) {
+        row = 0;
+        stepped[0].Resize(layout.rows);
+        stepped[1].Resize(layout.rows);
+        over = false;
+        won = false;
+    }
+    bool Stepped(int row, int side) const { return stepped[side].Get(row); }
+};
+
+static inline BridgeStep StepBridge(const BridgeLayout &layout, BridgeCrossing &c, int side) {
+    c.stepped[side].Set(c.row, true);
+    if (!layout.Safe(c.row, side)) {
+        c.over = true;
+        return STEP_BROKE;
+    }
+    if (++c.row >= layout.rows) {
+        c.over = c.won = true;
+        return STEP_CROSSED;
+    }
+    return STEP_HELD;
+}
+
+// ---------------------------
+// Batch Monte Carlo
+// ---------------------------
+
+const int BRIDGE_BATCH_WORDS = 64;  // words per block: 4096 groups share one pass over the rows
+const int BRIDGE_COUNT_PLANES = 32; // bits per death counter (a group loses at most 2 per row)
+
+struct BridgeBatchConfig {
+    int rows = BRIDGE_DEFAULT_ROWS;
+    int groupSize = 16;              // players crossing one after another
+    long long groups = 1000000;
+    BridgeRule rule = BRIDGE_COIN_FLIP;
+    const BridgeLayout *layout = nullptr; // fixed layout (players still guess), else a fresh one per group
+    uint64_t seed = 0;
+};
+
+struct BridgeBatchStats {
+    long long groups = 0;
+    std::vector<long long> crossed;   // [k]: groups in which the player at position k (0 = first) crossed
+    std::vector<long long> rowDeaths; // [r]: players lost on row r
+    long long blocked = 0;            // groups stopped by a row with both panels broken
+    long long deaths = 0;
+
+    double Survival(int position) const { return groups ? (double)crossed[position] / groups : 0.0; }
+};
+
+// Bit-sliced counters for a block of words: lane i of word w counts bit i of planes[0][w],
+// plus twice bit i of planes[1][w], and so on. Every loop runs across the words of one plane,
+// so it vectorizes.
+struct BlockCounters {
+    uint64_t planes[BRIDGE_COUNT_PLANES][BRIDGE_BATCH_WORDS] = {};
+    int used = 1; // planes that can be non-zero
+
+    // below[w]: lanes of word w whose count is < bound
+    void Below(uint64_t bound, int words, uint64_t *below) const {
+        if (bound >> used) {
+            std::fill(below, below + words, ~0ULL);
+            return;
+        }
+        // From the top bit down, a lane is decided at the first plane where it differs from bound
+        uint64_t equal[BRIDGE_BATCH_WORDS];
+        std::fill(below, below + words, 0);
+        std::fill(equal, equal + words, ~0ULL);
+        for (int p = used - 1; p >= 0; p--) {
+            uint64_t bit = (bound >> p) & 1 ? ~0ULL : 0;
+            for (int w = 0; w < words; w++) {
+                below[w] |= equal[w] & ~planes[p][w] & bit;
+                equal[w] &= ~(planes[p][w] ^ bit);
+            }
+        }
+    }
+
+    // Adds 1 in the lanes of one[w] and 2 in the lanes of two[w] (disjoint)
+    void Add12(const uint64_t *one, const uint64_t *two, int words) {
+        uint64_t carry[BRIDGE_BATCH_WORDS];
+        for (int w = 0; w < words; w++) {
+            carry[w] = planes[0][w] & one[w];
+            planes[0][w] ^= one[w];
+        }
+        for (int w = 0; w < words; w++) {
+            uint64_t a = planes[1][w];
+            planes[1][w] = a ^ two[w] ^ carry[w];
+            carry[w] = (a & (two[w] | carry[w])) | (two[w] & carry[w]);
+        }
+        for (int p = 2; p < used; p++)
+            for (int w = 0; w < words; w++) {
+                uint64_t a = planes[p][w];
+                planes[p][w] = a ^ carry[w];
+                carry[w] = a & carry[w];
+            }
+    }
+};
+
+// Plays one block of up to 64 * BRIDGE_BATCH_WORDS groups and adds its counts to stats
+static inline void SimulateBridgeBlock(const BridgeBatchConfig &cfg, long long firstGroup, Pcg32 &rng,
+                                       BridgeBatchStats &stats) {
+    const int words = (int)std::min<long long>(BRIDGE_BATCH_WORDS, (cfg.groups - firstGroup + 63) / 64);
+    BlockCounters deaths;
+    // Enough planes for two deaths on every row, plus one so Add12 always has a plane 1
+    while (deaths.used < BRIDGE_COUNT_PLANES && (2ULL * cfg.rows) >> deaths.used) deaths.used++;
+    deaths.used = std::max(deaths.used, 2);
+    const bool canRunOut = 2LL * cfg.rows >= cfg.groupSize; // else every guess has a player to make it
+
+    uint64_t valid[BRIDGE_BATCH_WORDS], blocked[BRIDGE_BATCH_WORDS];
+    for (int w = 0; w < words; w++) {
+        long long remaining = cfg.groups - firstGroup - 64LL * w;
+        valid[w] = remaining >= 64 ? ~0ULL : (1ULL << remaining) - 1;
+        blocked[w] = ~valid[w];
+    }
+    auto draw64 = [&rng] {
+        uint64_t high = rng.Next();
+        return high << 32 | rng.Next();
+    };
+
+    uint64_t chosen[BRIDGE_BATCH_WORDS], other[BRIDGE_BATCH_WORDS];
+    uint64_t one[BRIDGE_BATCH_WORDS], two[BRIDGE_BATCH_WORDS];
+    uint64_t hadOne[BRIDGE_BATCH_WORDS], hadTwo[BRIDGE_BATCH_WORDS];
+    for (int r = 0; r < cfg.rows; r++) {
+        // Does the guessed panel hold, does the other one? With a fresh random layout per group
+        // the guess is just "left": the layout bits are already uniform and independent of it.
+        if (cfg.layout) {
+            uint64_t left = cfg.layout->Safe(r, 0) ? ~0ULL : 0, right = cfg.layout->Safe(r, 1) ? ~0ULL : 0;
+            for (int w = 0; w < words; w++) {
+                uint64_t guessRight = draw64();
+                chosen[w] = (guessRight & right) | (~guessRight & left);
+                other[w] = (guessRight & left) | (~guessRight & right);
+            }
+        } else {
+            for (int w = 0; w < words; w++) {
+                chosen[w] = draw64();
+                other[w] = cfg.rule == BRIDGE_ONE_SAFE ? ~chosen[w] : draw64();
+            }
+        }
+
+        for (int w = 0; w < words; w++) {
+            uint64_t broke = ~blocked[w] & ~chosen[w]; // the first guess fell through
+            two[w] = broke & ~other[w];                // so did the next player's: the row is impassable
+            one[w] = broke & ~two[w];
+            blocked[w] |= two[w];
+        }
+
+        // Only count players the group still has
+        long long lost = 0;
+        if (canRunOut) {
+            deaths.Below((uint64_t)cfg.groupSize, words, hadOne);
+            deaths.Below((uint64_t)std::max(cfg.groupSize - 1, 0), words, hadTwo);
+            for (int w = 0; w < words; w++)
+                lost += PopCount64((one[w] | two[w]) & hadOne[w]) + PopCount64(two[w] & hadTwo[w]);
+        } else {
+            for (int w = 0; w < words; w++) lost += PopCount64(one[w]) + 2 * PopCount64(two[w]);
+        }
+        stats.rowDeaths[r] += lost;
+        deaths.Add12(one, two, words);
+    }
+
+    uint64_t crossed[BRIDGE_BATCH_WORDS];
+    for (int w = 0; w < words; w++) stats.blocked += PopCount64(blocked[w] & valid[w]);
+    // Player k crosses when at most k players died ahead of them
+    for (int k = 0; k < cfg.groupSize; k++) {
+        deaths.Below((uint64_t)k + 1, words, crossed);
+        for (int w = 0; w < words; w++) stats.crossed[k] += PopCount64(crossed[w] & ~blocked[w]);
+    }
+}
+
+// Deterministic for a given seed whatever the thread count: each block draws from its own stream
+static inline BridgeBatchStats SimulateBridgeBatch(const BridgeBatchConfig &cfg, TickScheduler *scheduler = nullptr) {
+    const long long groupsPerBlock = 64LL * BRIDGE_BATCH_WORDS;
+    const long long blockCount = (cfg.groups + groupsPerBlock - 1) / groupsPerBlock;
+    std::vector<BridgeBatchStats> partial(blockCount);
+    auto runBlock = [&](int block) {
+        BridgeBatchStats &s = partial[block];
+        s.crossed.assign(cfg.groupSize, 0);
+        s.rowDeaths.assign(cfg.rows, 0);
+        Pcg32 rng(cfg.seed, ((uint64_t)STREAM_BRIDGE << 40) + (uint64_t)block);
+        SimulateBridgeBlock(cfg, block * groupsPerBlock, rng, s);
+    };
+    if (scheduler) scheduler->ParallelFor((int)blockCount, runBlock);
+    else for (int b = 0; b < (int)blockCount; b++) runBlock(b);
+
+    BridgeBatchStats total;
+    total.groups = cfg.groups;
+    total.crossed.assign(cfg.groupSize, 0);
+    total.rowDeaths.assign(cfg.rows, 0);
+    for (const BridgeBatchStats &s : partial) {
+        for (int k = 0; k < cfg.groupSize; k++) total.crossed[k] += s.crossed[k];
+        for (int r = 0; r < cfg.rows; r++) total.rowDeaths[r] += s.rowDeaths[r];
+        total.blocked += s.blocked;
+    }
+    for (long long d : total.rowDeaths) total.deaths += d;
+    return total;
+}
@@ -0,0 +1,190 @@
+// Glass Bridge scene
+// Pick the left or right glass panel on each row; half of them break. Hosted by bridge.cpp on
+// its own or by the squid_game hub. The rules live in bridge_engine.h.
+#pragma once
+#include <raylib.h>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include "bridge_engine.h"
+#include "scene.h"
+#include "sim_random.h"
+
+class BridgeScene : public Scene {
+public:
+    // Input bindings (bit index in InputFrame)
+    enum BridgeInput { IN_LEFT, IN_RIGHT, IN_SPACE, IN_ENTER, IN_RESTART };
+
+    explicit BridgeScene(int rowCount = BRIDGE_DEFAULT_ROWS) : rows(std::max(rowCount, 1)) {}
+
+    ReplayGame ReplayId() const override { return REPLAY_BRIDGE; }
+    std::vector<int> Bindings() const override { return {KEY_LEFT, KEY_RIGHT, KEY_SPACE, KEY_ENTER, KEY_R}; }
+
+    bool Init(const SceneContext &ctx) override {
+        assets = ctx.assets;
+        results = ctx.results;
+        playerName = ctx.playerName;
+        if (assets) {
+            playerSprite = assets->AcquireSprite("456.png");
+            if (!playerSprite.Valid()) {
+                printf("Failed to load 456.png. Make sure it is in the correct folder.\n");
+                assets->Release("456.png");
+                return false;
+            }
+            breakSound = assets->AcquireSound("glass_break.mp3"); // Add glass_break.wav in folder
+        }
+        rng.Seed(ctx.seed, STREAM_BRIDGE);
+
+        // Dynamic scaling for the host's resolution
+        screenWidth = ctx.width;
+        screenHeight = ctx.height;
+        panelWidth = screenWidth * 0.15f;   // wider panels
+        panelHeight = screenHeight * 0.07f; // taller panels
+        gap = screenHeight * 0.025f;        // more gap between panels
+
+        titleHeight = screenHeight * 0.09f;
+        instructionHeight = screenHeight * 0.13f;
+        topMargin = titleHeight + instructionHeight + screenHeight * 0.06f; // more space above bridge
+        bottomMargin = screenHeight * 0.18f; // more space for progress bar
+
+        // Font sizes
+        titleFontSize = screenHeight / 14;
+        instructionFontSize = screenHeight / 38;
+        messageFontSize = screenHeight / 28;
+        progressFontSize = screenHeight / 32;
+
+        // Squeeze long bridges into the space between the message and the progress bar
+        float room = screenHeight - bottomMargin - topMargin;
+        if (rows * (panelHeight + gap) > room) {
+            float scale = room / (rows * (panelHeight + gap));
+            panelHeight *= scale;
+            gap *= scale;
+        }
+        return true;
+    }
+
+    void Enter() override { NewBridge(); }
+
+    void Update(const InputFrame &in) override {
+        if (!crossing.over) {
+            if (in.Pressed(IN_LEFT)) selectedSide = 0;
+            if (in.Pressed(IN_RIGHT)) selectedSide = 1;
+
+            if (in.Pressed(IN_SPACE) || in.Pressed(IN_ENTER)) {
+                BridgeStep step = StepBridge(layout, crossing, selectedSide);
+                if (step == STEP_BROKE) {
+                    PlaySound(breakSound);
+                    message = "❌ You stepped on broken glass! Game Over.";
+                    if (results) results->Record(REPLAY_BRIDGE, playerName.c_str(), RESULT_LOST);
+                } else if (step == STEP_CROSSED) {
+                    message = "✅ You crossed safely! You Win!";
+                    if (results) results->Record(REPLAY_BRIDGE, playerName.c_str(), RESULT_WON);
+                }
+            }
+        } else if (in.Pressed(IN_RESTART)) {
+            NewBridge();
+        }
+    }
+
+    void Draw(float, const InputFrame &) override {
+        ClearBackground((Color){230, 240, 255, 255});
+
+        // Title
+        DrawRectangle(0, 0, screenWidth, titleHeight, (Color){50, 100, 150, 220});
+        const char* titleText = "🪞 Squid Game: Glass Bridge 🪞";
+        DrawText(titleText, screenWidth / 2 - MeasureText(titleText, titleFontSize) / 2, titleHeight * 0.25f, titleFontSize, RAYWHITE);
+
+        // Instructions
+        DrawRectangle(screenWidth * 0.025f, titleHeight + 5, screenWidth * 0.95f, instructionHeight, (Color){255, 255, 255, 230});
+        DrawText("Use LEFT/RIGHT to select panel, SPACE/ENTER to step.", screenWidth * 0.05f, titleHeight + 15, instructionFontSize, DARKGRAY);
+        DrawText("Avoid broken glass! Reach the top. Press R to restart.", screenWidth * 0.05f, titleHeight + 45, instructionFontSize, DARKGRAY);
+
+        // Game message (separated above bridge)
+        int msgWidth = MeasureText(message.c_str(), messageFontSize);
+        DrawText(message.c_str(), screenWidth / 2 - msgWidth / 2, titleHeight + instructionHeight + 20, messageFontSize, (crossing.won ? GREEN : RED));
+
+        // Bridge
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < 2; j++) {
+                bool safe = layout.Safe(i, j);
+                Color baseColor = safe ? (Color){200, 230, 255, 255} : (Color){255, 200, 200, 255};
+                if (crossing.Stepped(i, j)) {
+                    baseColor = safe ? (Color){50, 150, 255, 255} : (Color){255, 50, 50, 255};
+                }
+                Rectangle rect = PanelRect(i, j);
+                DrawRectangle(rect.x + 4, rect.y + 4, panelWidth, panelHeight, (Color){0, 0, 0, 40});
+                DrawRectangleRec(rect, baseColor);
+                DrawRectangleLinesEx(rect, 2, (Color){80, 80, 80, 180});
+            }
+        }
+
+        // Player
+        if (!crossing.over) {
+            Rectangle panelRect = PanelRect(crossing.row, selectedSide);
+            float imgWidth = panelWidth * 0.4f;
+            float imgHeight = panelHeight * 1.6f;
+            float imgX = panelRect.x + panelRect.width / 2.0f - imgWidth / 2.0f;
+            float imgY = panelRect.y - imgHeight - 15; // more gap above panel
+            DrawSprite(playerSprite, {imgX, imgY, imgWidth, imgHeight}, WHITE);
+        }
+
+        // Progress bar (moved further down)
+        Rectangle progressBarBg = {screenWidth / 2.0f - screenWidth * 0.25f, screenHeight - bottomMargin + 40, screenWidth * 0.5f, 30};
+        DrawRectangleRec(progressBarBg, (Color){200, 200, 200, 180});
+        DrawRectangleLinesEx(progressBarBg, 2, (Color){100, 100, 100, 200});
+
+        float progressPercent = (float)crossing.row / rows;
+        Rectangle progressBarFill = {progressBarBg.x + 3, progressBarBg.y + 3, (progressBarBg.width - 6) * progressPercent, progressBarBg.height - 6};
+        DrawRectangleRec(progressBarFill, (Color){30, 144, 255, 220});
+
+        // Progress text
+        std::string progressText = "Progress: " + std::to_string(crossing.row) + " / " + std::to_string(rows);
+        DrawText(progressText.c_str(), screenWidth / 2 - MeasureText(progressText.c_str(), progressFontSize) / 2, progressBarBg.y + 5, progressFontSize, BLACK);
+
+        // Restart hint
+        if (crossing.over) {
+            std::string restartMsg = "Press R to Restart";
+            int restartWidth = MeasureText(restartMsg.c_str(), progressFontSize);
+            DrawText(restartMsg.c_str(), screenWidth / 2 - restartWidth / 2, screenHeight - bottomMargin / 2, progressFontSize, (Color){100, 100, 100, 180});
+        }
+    }
+
+    int IdleTicks() const override { return SCENE_IDLE_UNTIL_INPUT; } // only key presses change anything
+
+    void Shutdown() override {
+        if (!assets) return;
+        assets->Release("456.png");
+        assets->Release("glass_break.mp3");
+    }
+
+private:
+    void NewBridge() {
+        message = "Use LEFT/RIGHT to select, SPACE/ENTER to step";
+        selectedSide = 0;
+        GenerateBridge(layout, rows, BRIDGE_COIN_FLIP, rng);
+        crossing.Reset(layout);
+    }
+
+    Rectangle PanelRect(int row, int side) const {
+        return {screenWidth / 2.0f - panelWidth - gap + side * (panelWidth + gap), topMargin + row * (panelHeight + gap),
+                panelWidth, panelHeight};
+    }
+
+    AssetCache *assets = nullptr;
+    TournamentResults *results = nullptr;
+    std::string playerName;
+    Sprite playerSprite; // from the host's atlas when it has one
+    Sound breakSound = {};
+    Pcg32 rng;
+    int rows;
+    BridgeLayout layout;
+    BridgeCrossing crossing;
+
+    int screenWidth = 0, screenHeight = 0;
+    float panelWidth = 0, panelHeight = 0, gap = 0;
+    float titleHeight = 0, instructionHeight = 0, topMargin = 0, bottomMargin = 0;
+    int titleFontSize = 0, instructionFontSize = 0, messageFontSize = 0, progressFontSize = 0;
+
+    std::string message;
+    int selectedSide = 0;
+};
@@ -0,0 +1,72 @@
+// Headless glass bridge simulator
+// Sends many groups of players across the bridge one after another and reports how likely each
+// position in the line is to survive, where the players fall and how fast the batch runs.
+//
+//   g++ -std=c++17 -O2 -pthread bridge_sim.cpp -o bridge_sim
+//   ./bridge_sim --rows 18 --players 16 --groups 10000000 --rule show --threads 0
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "bridge_engine.h"
+
+int main(int argc, char **argv) {
+    BridgeBatchConfig cfg;
+    int threads = 1;
+    const char *layoutText = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--rows") && hasValue) cfg.rows = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--players") && hasValue) cfg.groupSize = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--groups") && hasValue) cfg.groups = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && hasValue) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue) cfg.seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--layout") && hasValue) layoutText = argv[++i];
+        else if (!strcmp(argv[i], "--rule") && hasValue && !strcmp(argv[i + 1], "coin")) cfg.rule = BRIDGE_COIN_FLIP, i++;
+        else if (!strcmp(argv[i], "--rule") && hasValue && !strcmp(argv[i + 1], "show")) cfg.rule = BRIDGE_ONE_SAFE, i++;
+        else {
+            printf("Usage: %s [--rows N] [--players N] [--groups N] [--rule coin|show] [--threads N (0 = all cores)]\n"
+                   "          [--seed S] [--layout PANELS (one of L R B N per row: left, right, both or no safe panel)]\n",
+                   argv[0]);
+            return 1;
+        }
+    }
+
+    BridgeLayout layout;
+    if (layoutText) {
+        cfg.rows = (int)strlen(layoutText);
+        layout.Resize(cfg.rows);
+        for (int r = 0; r < cfg.rows; r++) {
+            char c = layoutText[r];
+            if (!strchr("LRBN", c)) {
+                printf("Layout letters are L, R, B or N, not '%c'.\n", c);
+                return 1;
+            }
+            layout.safe[0].Set(r, c == 'L' || c == 'B');
+            layout.safe[1].Set(r, c == 'R' || c == 'B');
+        }
+        cfg.layout = &layout;
+    }
+    if (cfg.rows <= 0 || cfg.groupSize <= 0 || cfg.groups <= 0) {
+        printf("Rows, players and groups must be positive.\n");
+        return 1;
+    }
+
+    TickScheduler scheduler(threads);
+    auto start = std::chrono::steady_clock::now();
+    BridgeBatchStats stats = SimulateBridgeBatch(cfg, &scheduler);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%lld groups of %d, %d rows, %s, %d thread(s)\n", cfg.groups, cfg.groupSize, cfg.rows,
+           layoutText ? "fixed layout" : cfg.rule == BRIDGE_ONE_SAFE ? "one safe panel per row" : "coin-flip panels",
+           scheduler.ThreadCount());
+    printf("\nPosition  Survival\n");
+    for (int k = 0; k < cfg.groupSize; k++) printf("%8d  %7.3f%%\n", k + 1, 100.0 * stats.Survival(k));
+    printf("\nRow  Deaths per group\n");
+    for (int r = 0; r < cfg.rows; r++) printf("%3d  %.4f\n", r + 1, (double)stats.rowDeaths[r] / cfg.groups);
+    printf("\nBlocked (a row with no safe panel): %.3f%%\n", 100.0 * stats.blocked / cfg.groups);
+    printf("Expected deaths per group: %.4f\n", (double)stats.deaths / cfg.groups);
+    printf("%.3f s, %.1f M groups/s\n", seconds, cfg.groups / seconds / 1e6);
+    return 0;
+}
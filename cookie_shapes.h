@@ -0,0 +1,397 @@
+// Procedural Dalgona cookie shapes
+// A shape is a vector path (lines, quadratic and cubic Béziers) in cookie units: the cookie is the
+// unit disc around the origin, y pointing down. For a given image size the path is flattened into
+// segments, indexed by a uniform grid and measured into beads one pixel apart along its length.
+// The outline test, the scratch progress and the cookie texture all come from that, so a shape
+// costs a few kilobytes at any resolution and a new shape is a few lines here, not another bitmap.
+#pragma once
+#include <raylib.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "dalgona_outline.h"
+#include "tiled_bitset.h"
+
+const float COOKIE_FLATTEN_TOLERANCE = 0.25f; // max pixels between a curve and its segments
+const float COOKIE_GRID_CELL = 16.0f;         // pixels per side of a spatial index cell
+const float COOKIE_BEAD_SPACING = 1.0f;       // pixels of outline per progress bead
+const float COOKIE_GROOVE_WIDTH = 0.02f;      // pressed line width, in cookie radii
+const Color COOKIE_CENTER_COLOR = {232, 172, 82, 255};
+const Color COOKIE_RIM_COLOR = {192, 122, 46, 255};
+const Color COOKIE_GROOVE_COLOR = {118, 64, 22, 255};
+
+// ---------------------------
+// Paths
+// ---------------------------
+
+enum PathVerb { PATH_MOVE, PATH_LINE, PATH_QUAD, PATH_CUBIC, PATH_CLOSE };
+
+struct CookiePath {
+    struct Command {
+        PathVerb verb;
+        Vector2 p[3]; // control points, then the end point
+    };
+    std::vector<Command> commands;
+
+    CookiePath &MoveTo(float x, float y) { return Add({PATH_MOVE, {{x, y}}}); }
+    CookiePath &LineTo(float x, float y) { return Add({PATH_LINE, {{x, y}}}); }
+    CookiePath &QuadTo(float cx, float cy, float x, float y) { return Add({PATH_QUAD, {{cx, cy}, {x, y}}}); }
+    CookiePath &CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) {
+        return Add({PATH_CUBIC, {{c1x, c1y}, {c2x, c2y}, {x, y}}});
+    }
+    CookiePath &Close() { return Add({PATH_CLOSE, {}}); }
+
+private:
+    CookiePath &Add(const Command &c) {
+        commands.push_back(c);
+        return *this;
+    }
+};
+
+static inline Vector2 PathLerp(Vector2 a, Vector2 b, float t) { return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t}; }
+static inline float PathLength(float x, float y) { return sqrtf(x * x + y * y); }
+
+// Calls segment(from, to) for each line segment of the path in pixels (point * scale + origin).
+// A curve is cut into n equal parameter steps, with n from the largest second difference of its
+// control points (Wang's formula), which keeps every piece within tolerance of the curve.
+template <typename Fn>
+static inline void FlattenCookiePath(const CookiePath &path, float scale, Vector2 origin, float tolerance, Fn segment) {
+    auto map = [&](Vector2 p) { return Vector2{p.x * scale + origin.x, p.y * scale + origin.y}; };
+    auto secondDiff = [](Vector2 a, Vector2 b, Vector2 c) { return PathLength(a.x - 2 * b.x + c.x, a.y - 2 * b.y + c.y); };
+    Vector2 start = {0, 0}, pen = {0, 0};
+    for (const CookiePath::Command &c : path.commands) {
+        switch (c.verb) {
+        case PATH_MOVE:
+            start = pen = map(c.p[0]);
+            break;
+        case PATH_LINE: {
+            Vector2 to = map(c.p[0]);
+            segment(pen, to);
+            pen = to;
+            break;
+        }
+        case PATH_QUAD: {
+            Vector2 a = pen, b = map(c.p[0]), d = map(c.p[1]);
+            int n = std::max(1, (int)ceilf(sqrtf(secondDiff(a, b, d) / (4.0f * tolerance))));
+            for (int i = 1; i <= n; i++) {
+                float t = (float)i / n;
+                Vector2 q = i == n ? d : PathLerp(PathLerp(a, b, t), PathLerp(b, d, t), t);
+                segment(pen, q);
+                pen = q;
+            }
+            break;
+        }
+        case PATH_CUBIC: {
+            Vector2 a = pen, b = map(c.p[0]), e = map(c.p[1]), d = map(c.p[2]);
+            float m = std::max(secondDiff(a, b, e), secondDiff(b, e, d));
+            int n = std::max(1, (int)ceilf(sqrtf(3.0f * m / (4.0f * tolerance))));
+            for (int i = 1; i <= n; i++) {
+                float t = (float)i / n;
+                Vector2 ab = PathLerp(a, b, t), be = PathLerp(b, e, t), ed = PathLerp(e, d, t);
+                Vector2 q = i == n ? d : PathLerp(PathLerp(ab, be, t), PathLerp(be, ed, t), t);
+                segment(pen, q);
+                pen = q;
+            }
+            break;
+        }
+        case PATH_CLOSE:
+            segment(pen, start);
+            pen = start;
+            break;
+        }
+    }
+}
+
+// ---------------------------
+// Shape catalog
+// ---------------------------
+
+static inline CookiePath CirclePath(float r) {
+    const float k = 0.5523f * r; // control distance for a quarter circle
+    return CookiePath()
+        .MoveTo(r, 0)
+        .CubicTo(r, k, k, r, 0, r)
+        .CubicTo(-k, r, -r, k, -r, 0)
+        .CubicTo(-r, -k, -k, -r, 0, -r)
+        .CubicTo(k, -r, r, -k, r, 0)
+        .Close();
+}
+
+// Corners on a circle of radius r, the first one straight up
+static inline CookiePath RegularPolygonPath(int sides, float r) {
+    CookiePath path;
+    for (int i = 0; i < sides; i++) {
+        float a = -PI / 2 + i * 2 * PI / sides;
+        if (i == 0) path.MoveTo(r * cosf(a), r * sinf(a));
+        else path.LineTo(r * cosf(a), r * sinf(a));
+    }
+    return path.Close();
+}
+
+static inline CookiePath StarPath(int points, float outer, float inner) {
+    CookiePath path;
+    for (int i = 0; i < 2 * points; i++) {
+        float a = -PI / 2 + i * PI / points;
+        float r = i % 2 ? inner : outer;
+        if (i == 0) path.MoveTo(r * cosf(a), r * sinf(a));
+        else path.LineTo(r * cosf(a), r * sinf(a));
+    }
+    return path.Close();
+}
+
+static inline CookiePath UmbrellaPath() {
+    CookiePath path;
+    // Canopy: a dome closed by four scallops that curve up between the rib tips
+    path.MoveTo(-0.62f, 0.02f)
+        .CubicTo(-0.62f, -0.34f, -0.34f, -0.56f, 0, -0.56f)
+        .CubicTo(0.34f, -0.56f, 0.62f, -0.34f, 0.62f, 0.02f);
+    for (int i = 0; i < 4; i++) {
+        float x0 = 0.62f - i * 0.31f, x1 = x0 - 0.31f;
+        path.QuadTo((x0 + x1) / 2, -0.1f, x1, 0.02f);
+    }
+    path.Close();
+    // Tip and a hooked handle, both open strokes
+    path.MoveTo(0, -0.56f).LineTo(0, -0.64f);
+    path.MoveTo(0, 0.02f).LineTo(0, 0.44f).CubicTo(0, 0.62f, -0.26f, 0.62f, -0.26f, 0.44f).LineTo(-0.26f, 0.38f);
+    return path;
+}
+
+static inline CookiePath HeartPath(float s) {
+    return CookiePath()
+        .MoveTo(0, -0.3f * s)
+        .CubicTo(0.2f * s, -0.75f * s, 0.95f * s, -0.5f * s, 0.55f * s, 0.05f * s)
+        .LineTo(0, 0.6f * s)
+        .LineTo(-0.55f * s, 0.05f * s)
+        .CubicTo(-0.95f * s, -0.5f * s, -0.2f * s, -0.75f * s, 0, -0.3f * s)
+        .Close();
+}
+
+struct CookieShape {
+    const char *name;
+    CookiePath (*make)();
+};
+
+const CookieShape COOKIE_SHAPES[] = {
+    {"circle", [] { return CirclePath(0.55f); }},
+    {"triangle", [] { return RegularPolygonPath(3, 0.64f); }},
+    {"umbrella", [] { return UmbrellaPath(); }},
+    {"star", [] { return StarPath(5, 0.64f, 0.26f); }},
+    {"heart", [] { return HeartPath(1.0f); }},
+};
+const int COOKIE_SHAPE_COUNT = (int)(sizeof(COOKIE_SHAPES) / sizeof(COOKIE_SHAPES[0]));
+
+// ---------------------------
+// Outline: flattened segments, grid index and progress beads
+// ---------------------------
+
+struct CookieOutline {
+    int size = 0;                    // image is size x size pixels, the cookie disc fills it
+    float radius = 0.0f;             // cookie radius in pixels
+    float grooveHalfWidth = 0.0f;    // half the pressed line width in pixels
+    std::vector<Vector2> from, to;   // flattened segments in pixels
+    std::vector<float> along;        // outline length before each segment; along.back() is the total
+    int beads = 0;                   // progress points, one every COOKIE_BEAD_SPACING pixels of outline
+    int cells = 0;                   // grid cells per side
+    std::vector<int> cellFirst;      // segments of cell c: cellSegments[cellFirst[c] .. cellFirst[c + 1])
+    std::vector<int> cellSegments;
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < size && y >= 0 && y < size; }
+    float Length() const { return along.empty() ? 0.0f : along.back(); }
+
+    // Calls fn(segment) for each segment stored in a cell overlapping the square of half-size r
+    // around p. A segment that spans several of those cells is visited once per cell.
+    template <typename Fn>
+    void ForEachSegmentNear(Vector2 p, float r, Fn fn) const {
+        int cx0 = (int)floorf((p.x - r) / COOKIE_GRID_CELL), cx1 = (int)floorf((p.x + r) / COOKIE_GRID_CELL);
+        int cy0 = (int)floorf((p.y - r) / COOKIE_GRID_CELL), cy1 = (int)floorf((p.y + r) / COOKIE_GRID_CELL);
+        if (cx1 < 0 || cy1 < 0 || cx0 >= cells || cy0 >= cells) return;
+        cx0 = std::max(cx0, 0), cy0 = std::max(cy0, 0);
+        cx1 = std::min(cx1, cells - 1), cy1 = std::min(cy1, cells - 1);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++) {
+                int c = cy * cells + cx;
+                for (int i = cellFirst[c]; i < cellFirst[c + 1]; i++) fn(cellSegments[i]);
+            }
+    }
+
+    float SegmentDistance(int s, Vector2 p) const {
+        float dx = to[s].x - from[s].x, dy = to[s].y - from[s].y;
+        float len2 = dx * dx + dy * dy;
+        float t = len2 > 0 ? std::clamp(((p.x - from[s].x) * dx + (p.y - from[s].y) * dy) / len2, 0.0f, 1.0f) : 0.0f;
+        return PathLength(p.x - from[s].x - dx * t, p.y - from[s].y - dy * t);
+    }
+
+    // Distance from p to the outline, or maxDistance if nothing is closer
+    float Distance(Vector2 p, float maxDistance) const {
+        float best = maxDistance;
+        ForEachSegmentNear(p, maxDistance, [&](int s) { best = std::min(best, SegmentDistance(s, p)); });
+        return best;
+    }
+};
+
+static inline CookieOutline BuildCookieOutline(const CookiePath &path, int size) {
+    CookieOutline outline;
+    outline.size = size;
+    outline.radius = size * 0.5f - 1.0f;
+    outline.grooveHalfWidth = std::max(1.0f, COOKIE_GROOVE_WIDTH * outline.radius * 0.5f);
+    Vector2 center = {size * 0.5f, size * 0.5f};
+    float length = 0.0f;
+    FlattenCookiePath(path, outline.radius, center, COOKIE_FLATTEN_TOLERANCE, [&](Vector2 a, Vector2 b) {
+        float len = PathLength(b.x - a.x, b.y - a.y);
+        if (len <= 0.0f) return;
+        outline.from.push_back(a);
+        outline.to.push_back(b);
+        outline.along.push_back(length);
+        length += len;
+    });
+    outline.along.push_back(length);
+    outline.beads = (int)ceilf(length / COOKIE_BEAD_SPACING);
+
+    // A segment goes into every cell of its bounding box whose centre is within half a cell
+    // diagonal of it, i.e. every cell it passes through; counted first, then filled in place
+    outline.cells = std::max(1, (int)ceilf(size / COOKIE_GRID_CELL));
+    const int cells = outline.cells;
+    const float reach = COOKIE_GRID_CELL * 0.7072f;
+    auto forEachCell = [&](int s, auto fn) {
+        auto cellOf = [&](float v) { return std::clamp((int)floorf(v / COOKIE_GRID_CELL), 0, cells - 1); };
+        int cx0 = cellOf(std::min(outline.from[s].x, outline.to[s].x)), cx1 = cellOf(std::max(outline.from[s].x, outline.to[s].x));
+        int cy0 = cellOf(std::min(outline.from[s].y, outline.to[s].y)), cy1 = cellOf(std::max(outline.from[s].y, outline.to[s].y));
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++) {
+                Vector2 mid = {(cx + 0.5f) * COOKIE_GRID_CELL, (cy + 0.5f) * COOKIE_GRID_CELL};
+                if (outline.SegmentDistance(s, mid) <= reach) fn(cy * cells + cx);
+            }
+    };
+    const int segments = (int)outline.from.size();
+    outline.cellFirst.assign((size_t)cells * cells + 1, 0);
+    for (int s = 0; s < segments; s++) forEachCell(s, [&](int c) { outline.cellFirst[c + 1]++; });
+    for (int c = 0; c < cells * cells; c++) outline.cellFirst[c + 1] += outline.cellFirst[c];
+    outline.cellSegments.resize(outline.cellFirst.back());
+    std::vector<int> fill(outline.cellFirst.begin(), outline.cellFirst.end() - 1);
+    for (int s = 0; s < segments; s++) forEachCell(s, [&](int c) { outline.cellSegments[fill[c]++] = s; });
+    return outline;
+}
+
+// Cookie texture: a caramel disc, lighter in the middle, with a fixed grain and the outline
+// pressed in as an antialiased groove
+static inline Image GenCookieImage(const CookieOutline &outline) {
+    const int size = outline.size;
+    Image img = GenImageColor(size, size, BLANK);
+    Color *pixels = (Color *)img.data;
+    const float c = size * 0.5f;
+    const float groove = outline.grooveHalfWidth;
+    auto mix = [](Color a, Color b, float t) {
+        return Color{(unsigned char)(a.r + (b.r - a.r) * t), (unsigned char)(a.g + (b.g - a.g) * t),
+                     (unsigned char)(a.b + (b.b - a.b) * t), 255};
+    };
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            Vector2 p = {x + 0.5f, y + 0.5f};
+            float r = PathLength(p.x - c, p.y - c);
+            float coverage = std::clamp(outline.radius - r + 0.5f, 0.0f, 1.0f);
+            if (coverage <= 0.0f) continue;
+            float shade = r / outline.radius;
+            Color color = mix(COOKIE_CENTER_COLOR, COOKIE_RIM_COLOR, shade * shade);
+            uint32_t h = ((uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u) * 0x9E3779B1u;
+            int grain = (int)(h >> 28) - 8;
+            color.r = (unsigned char)std::clamp(color.r + grain, 0, 255);
+            color.g = (unsigned char)std::clamp(color.g + grain, 0, 255);
+            color.b = (unsigned char)std::clamp(color.b + grain, 0, 255);
+            float pressed = std::clamp(groove + 0.5f - outline.Distance(p, groove + 1.0f), 0.0f, 1.0f);
+            if (pressed > 0.0f) color = mix(color, COOKIE_GROOVE_COLOR, pressed);
+            color.a = (unsigned char)(coverage * 255.0f);
+            pixels[y * size + x] = color;
+        }
+    }
+    return img;
+}
+
+// ---------------------------
+// Scratching
+// ---------------------------
+
+// Which beads have been scratched, plus the positions of the ones scratched since the last
+// StampCookieScratches, for the overlay
+struct CookieScratch {
+    std::vector<uint64_t> bits;
+    int count = 0;
+    std::vector<Vector2> fresh;
+
+    CookieScratch() = default;
+    explicit CookieScratch(int beads) : bits((beads + 63) / 64, 0) {}
+
+    // Returns true if the bead was newly scratched
+    bool Set(int bead) {
+        uint64_t bit = 1ULL << (bead & 63);
+        if (bits[bead >> 6] & bit) return false;
+        bits[bead >> 6] |= bit;
+        count++;
+        return true;
+    }
+
+    void Clear() {
+        std::fill(bits.begin(), bits.end(), 0);
+        count = 0;
+        fresh.clear();
+    }
+};
+
+// Scratch every bead within r of p; returns false if no part of the outline is that close.
+// Each nearby segment is cut to the stretch inside the circle, so only beads that are hit are
+// touched.
+static inline bool ScratchCookieNear(const CookieOutline &outline, Vector2 p, float r, CookieScratch &scratched) {
+    bool near = false;
+    outline.ForEachSegmentNear(p, r, [&](int s) {
+        Vector2 a = outline.from[s];
+        float len = outline.along[s + 1] - outline.along[s];
+        float dx = (outline.to[s].x - a.x) / len, dy = (outline.to[s].y - a.y) / len;
+        float t = (p.x - a.x) * dx + (p.y - a.y) * dy; // along the segment, in pixels
+        float ox = p.x - a.x - dx * t, oy = p.y - a.y - dy * t;
+        float side2 = r * r - (ox * ox + oy * oy);
+        if (side2 < 0.0f) return;
+        float half = sqrtf(side2);
+        float lo = std::max(t - half, 0.0f), hi = std::min(t + half, len);
+        if (lo > hi) return;
+        near = true;
+        int k0 = (int)ceilf((outline.along[s] + lo) / COOKIE_BEAD_SPACING);
+        int k1 = std::min((int)floorf((outline.along[s] + hi) / COOKIE_BEAD_SPACING), outline.beads - 1);
+        for (int k = k0; k <= k1; k++) {
+            if (!scratched.Set(k)) continue;
+            float at = k * COOKIE_BEAD_SPACING - outline.along[s];
+            scratched.fresh.push_back({a.x + dx * at, a.y + dy * at});
+        }
+    });
+    return near;
+}
+
+// Scratches along the stroke between two mouse samples, pixel by pixel as ScratchOutlineAlong
+// does for bitmap outlines. hit: some outline was in reach; missed: some point of the stroke on
+// the cookie was not near any. Points off the image are skipped.
+static inline StrokeScratch ScratchCookieAlong(const CookieOutline &outline, int x0, int y0, int x1, int y1, float radius,
+                                               CookieScratch &scratched) {
+    StrokeScratch result;
+    ForEachStrokePixel(x0, y0, x1, y1, [&](int x, int y) {
+        if (!outline.InBounds(x, y)) return;
+        if (ScratchCookieNear(outline, {x + 0.5f, y + 0.5f}, radius, scratched)) result.hit = true;
+        else result.missed = true;
+    });
+    return result;
+}
+
+// Paint the beads scratched since the last call into a pixel mask as discs the width of the
+// groove, for the scratch overlay
+static inline void StampCookieScratches(const CookieOutline &outline, CookieScratch &scratched, TiledBitset &mask) {
+    const float r = outline.grooveHalfWidth;
+    const int reach = (int)ceilf(r);
+    for (Vector2 p : scratched.fresh) {
+        int px = (int)p.x, py = (int)p.y;
+        for (int y = py - reach; y <= py + reach; y++)
+            for (int x = px - reach; x <= px + reach; x++) {
+                if (!outline.InBounds(x, y)) continue;
+                float dx = x + 0.5f - p.x, dy = y + 0.5f - p.y;
+                if (dx * dx + dy * dy <= r * r) mask.Set(x, y);
+            }
+    }
+    scratched.fresh.clear();
+}
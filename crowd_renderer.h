@@ -0,0 +1,246 @@
+// Crowd renderer for large Red Light fields
+// Draws thousands of contestants from the sprite atlas through one SpriteBatch, i.e. one
+// streamed quad buffer and a handful of draw calls for the whole field. Only lanes inside the
+// camera's view are visited. A contestant is a tinted dot while lanes are a few pixels apart on
+// screen, and a glow plus portrait once they are big enough to see. Number labels are rendered
+// once into a cache texture and drawn from it, only for on-screen contestants at close zoom.
+#pragma once
+#include <raylib.h>
+#include <rlgl.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include "player_field.h"
+#include "sprite_atlas.h"
+#include "frame_profiler.h"
+
+const float CROWD_LANE_SPACING = 12.0f;       // world pixels between crowd lanes
+const float CROWD_SPRITE_MIN_LANE_PX = 16.0f; // lanes at least this far apart on screen get portraits
+const float CROWD_LABEL_MIN_LANE_PX = 24.0f;  // ... and number labels
+const float CROWD_DOT_MIN_PX = 1.5f;          // dots never shrink below this on screen
+const int CROWD_MAX_LABELS = 512;             // labels drawn per frame at most
+const int CROWD_LABEL_CACHE_SIZE = 1024;      // label cache texture is this square
+const int CROWD_LABEL_WIDTH = 64;
+const int CROWD_LABEL_HEIGHT = 20;
+const int CROWD_LABEL_FONT_SIZE = 16;
+const Color CROWD_PALETTE[] = {BLUE, RED, GREEN, GOLD, ORANGE, PURPLE, SKYBLUE, LIME};
+const int CROWD_PALETTE_SIZE = (int)(sizeof(CROWD_PALETTE) / sizeof(CROWD_PALETTE[0]));
+
+// --crowd N: bot contestants added to the Red Light field (0 when absent)
+static inline int CrowdSize(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (!strcmp(argv[i], "--crowd")) return std::max(atoi(argv[i + 1]), 0);
+    return 0;
+}
+
+// Where the crowd sits: field players [first, first + count), one lane each, top to bottom
+struct CrowdLayout {
+    size_t first = 0;
+    size_t count = 0;
+    float startY = 0.0f;  // world y of the first lane
+    int firstNumber = 1;  // number on the first contestant's label
+
+    float LaneY(size_t lane) const { return startY + lane * CROWD_LANE_SPACING; }
+    float Bottom() const { return LaneY(count); }
+};
+
+// Fixed-size label slots in one render texture, reused least-recently-drawn first (clock
+// sweep). A label is drawn into the texture once, when it first comes on screen.
+class CrowdLabelCache {
+public:
+    void Load(Font labelFont) {
+        font = labelFont;
+        target = LoadRenderTexture(CROWD_LABEL_CACHE_SIZE, CROWD_LABEL_CACHE_SIZE);
+        cols = CROWD_LABEL_CACHE_SIZE / CROWD_LABEL_WIDTH;
+        slots.assign((size_t)cols * (CROWD_LABEL_CACHE_SIZE / CROWD_LABEL_HEIGHT), Slot());
+        slotOf.clear();
+        hand = 0;
+    }
+
+    void Unload() {
+        if (target.id != 0) UnloadRenderTexture(target);
+        target = {};
+        slots.clear();
+        slotOf.clear();
+    }
+
+    // Slot holding key's label, queued for Render() if it isn't there yet; -1 if every slot is
+    // already showing a label this frame
+    int Acquire(int key, int number, uint64_t frame) {
+        auto it = slotOf.find(key);
+        if (it != slotOf.end()) {
+            slots[it->second].used = frame;
+            return it->second;
+        }
+        for (size_t tries = 0; tries < slots.size(); tries++) {
+            int s = hand;
+            hand = (hand + 1) % (int)slots.size();
+            if (slots[s].used == frame) continue;
+            if (slots[s].key >= 0) slotOf.erase(slots[s].key);
+            slots[s] = {key, frame};
+            slotOf[key] = s;
+            pending.push_back({s, number});
+            return s;
+        }
+        return -1;
+    }
+
+    // Draw the labels acquired since the last call into their slots. Outside BeginMode2D.
+    void Render() {
+        if (pending.empty()) return;
+        BeginTextureMode(target);
+        // Clear the slots: copy transparent pixels instead of blending them
+        rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM);
+        for (const PendingLabel &p : pending) {
+            Rectangle r = SlotRect(p.slot);
+            DrawRectangleRec(r, BLANK);
+        }
+        EndBlendMode();
+        for (const PendingLabel &p : pending) {
+            Rectangle r = SlotRect(p.slot);
+            const char *text = TextFormat("%03d", p.number);
+            Vector2 size = MeasureTextEx(font, text, CROWD_LABEL_FONT_SIZE, 1);
+            Vector2 at = {r.x + (r.width - size.x) / 2, r.y + (r.height - size.y) / 2};
+            DrawTextEx(font, text, {at.x + 1, at.y + 1}, CROWD_LABEL_FONT_SIZE, 1, BLACK);
+            DrawTextEx(font, text, at, CROWD_LABEL_FONT_SIZE, 1, WHITE);
+        }
+        EndTextureMode();
+        PROFILE_COUNT("crowd labels rendered", (int)pending.size());
+        pending.clear();
+    }
+
+    // Render textures are stored upside down, hence the negative source height
+    Sprite SlotSprite(int slot) const {
+        Rectangle r = SlotRect(slot);
+        return {target.texture, {r.x, CROWD_LABEL_CACHE_SIZE - r.y, r.width, -r.height}};
+    }
+
+private:
+    struct Slot {
+        int key = -1;
+        uint64_t used = 0; // frame the label was last drawn
+    };
+    struct PendingLabel {
+        int slot;
+        int number;
+    };
+
+    Rectangle SlotRect(int slot) const {
+        return {(float)(slot % cols * CROWD_LABEL_WIDTH), (float)(slot / cols * CROWD_LABEL_HEIGHT),
+                (float)CROWD_LABEL_WIDTH, (float)CROWD_LABEL_HEIGHT};
+    }
+
+    Font font = {};
+    RenderTexture2D target = {};
+    int cols = 1;
+    std::vector<Slot> slots;
+    std::unordered_map<int, int> slotOf; // key -> slot
+    std::vector<PendingLabel> pending;
+    int hand = 0;
+};
+
+class CrowdRenderer {
+public:
+    std::vector<Sprite> portraits; // cycled through by contestant
+    Sprite glow;                   // white disc, tinted
+    Sprite dot;                    // white square, tinted
+
+    void Load(Font font) { labels.Load(font); }
+    void Unload() { labels.Unload(); }
+
+    // Once per frame before BeginMode2D: cull to the camera's view, pick the level of detail and
+    // bring the label cache up to date. Positions interpolate from prevX to field.x by alpha.
+    void Prepare(const Camera2D &camera, int screenWidth, int screenHeight, const PlayerField &field,
+                 const float *prevX, float alpha, const CrowdLayout &layout) {
+        frame++;
+        visible.clear();
+        shownLabels.clear();
+        if (layout.count == 0) return;
+        PROFILE_SCOPE("crowd cull");
+
+        Vector2 topLeft = GetScreenToWorld2D({0, 0}, camera);
+        Vector2 bottomRight = GetScreenToWorld2D({(float)screenWidth, (float)screenHeight}, camera);
+        const float margin = CROWD_LANE_SPACING; // a sprite reaches this far past its centre
+        zoom = camera.zoom;
+        float lanePx = CROWD_LANE_SPACING * zoom;
+        detailed = lanePx >= CROWD_SPRITE_MIN_LANE_PX;
+        bool labelled = lanePx >= CROWD_LABEL_MIN_LANE_PX;
+
+        // Lanes are evenly spaced, so the visible ones are one index range
+        long long lane0 = (long long)floorf((topLeft.y - margin - layout.startY) / CROWD_LANE_SPACING);
+        long long lane1 = (long long)ceilf((bottomRight.y + margin - layout.startY) / CROWD_LANE_SPACING);
+        lane0 = std::max(lane0, 0LL);
+        lane1 = std::min(lane1, (long long)layout.count - 1);
+        for (long long lane = lane0; lane <= lane1; lane++) {
+            size_t i = layout.first + (size_t)lane;
+            if (!field.IsAlive(i) || field.IsFinished(i)) continue;
+            float x = prevX[i] + (field.x[i] - prevX[i]) * alpha;
+            if (x < topLeft.x - margin || x > bottomRight.x + margin) continue;
+            Vector2 pos = {x, layout.LaneY((size_t)lane)};
+            Color color = CROWD_PALETTE[lane % CROWD_PALETTE_SIZE];
+            if (detailed) {
+                float glowAmount = (sinf(field.glowPhase[i]) + 1.0f) / 2.0f;
+                color = {(unsigned char)(color.r + (255 - color.r) * glowAmount),
+                         (unsigned char)(color.g + (255 - color.g) * glowAmount),
+                         (unsigned char)(color.b + (255 - color.b) * glowAmount), 200};
+            }
+            visible.push_back({pos, color, (int)(lane % std::max<size_t>(portraits.size(), 1))});
+            if (labelled && shownLabels.size() < (size_t)CROWD_MAX_LABELS) {
+                int slot = labels.Acquire((int)lane, layout.firstNumber + (int)lane, frame);
+                Vector2 above = GetWorldToScreen2D({pos.x, pos.y - CROWD_LANE_SPACING / 2}, camera);
+                if (slot >= 0) shownLabels.push_back({above, slot});
+            }
+        }
+        labels.Render();
+        PROFILE_COUNT("crowd visible", (int)visible.size());
+        PROFILE_COUNT("crowd labels", (int)shownLabels.size());
+    }
+
+    // Inside BeginMode2D with the same camera; flush the batch afterwards
+    void DrawWorld(SpriteBatch &batch) const {
+        const float laneSize = CROWD_LANE_SPACING * 0.9f;
+        if (detailed) {
+            for (const Visible &v : visible) {
+                batch.DrawCentered(glow, v.pos, laneSize / std::max(glow.Height(), 1.0f), v.color);
+                if (portraits.empty()) continue;
+                const Sprite &portrait = portraits[v.portrait];
+                batch.DrawCentered(portrait, v.pos, laneSize / std::max(portrait.Height(), 1.0f), WHITE);
+            }
+        } else {
+            float size = std::max(CROWD_LANE_SPACING * 0.6f, CROWD_DOT_MIN_PX / zoom);
+            for (const Visible &v : visible)
+                batch.Draw(dot, {v.pos.x - size / 2, v.pos.y - size / 2, size, size}, v.color);
+        }
+    }
+
+    // After EndMode2D: labels at a fixed size above their contestants; flush the batch afterwards
+    void DrawLabels(SpriteBatch &batch) const {
+        for (const ShownLabel &l : shownLabels)
+            batch.Draw(labels.SlotSprite(l.slot),
+                       {l.screen.x - CROWD_LABEL_WIDTH / 2.0f, l.screen.y - CROWD_LABEL_HEIGHT,
+                        (float)CROWD_LABEL_WIDTH, (float)CROWD_LABEL_HEIGHT}, WHITE);
+    }
+
+private:
+    struct Visible {
+        Vector2 pos;
+        Color color;
+        int portrait;
+    };
+    struct ShownLabel {
+        Vector2 screen;
+        int slot;
+    };
+
+    CrowdLabelCache labels;
+    std::vector<Visible> visible;
+    std::vector<ShownLabel> shownLabels;
+    uint64_t frame = 0;
+    float zoom = 1.0f;
+    bool detailed = false;
+};
@@ -0,0 +1,168 @@
+// Dalgona outline preprocessing
+// Converts a cookie image into a compact outline bitmap plus a distance-to-outline
+// field once per shape, so tracing only needs table lookups while the mouse is down.
+#pragma once
+#include <raylib.h>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "image_kernels.h"
+#include "tiled_bitset.h"
+
+const int OUTLINE_DISTANCE_MAX = 255; // distances saturate here
+
+struct OutlineField {
+    int width = 0;
+    int height = 0;
+    int outlinePixels = 0;
+    TiledBitset visible;                 // alpha > 0, part of the cookie
+    TiledBitset outline;                 // part of the line the player has to trace
+    std::vector<unsigned char> distance; // chessboard distance to the nearest outline pixel
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    bool IsVisible(int x, int y) const { return visible.Test(x, y); }
+    bool IsOutline(int x, int y) const { return outline.Test(x, y); }
+
+    // True when an outline pixel lies inside the (2r+1)^2 square around (x,y).
+    // Chessboard distance matches the square window, so this is one lookup for any radius.
+    bool IsNearOutline(int x, int y, int radius) const {
+        return distance[y * width + x] <= radius;
+    }
+};
+
+// Two-pass chamfer transform with unit weights for all 8 neighbours (chessboard metric)
+static inline void ComputeChessboardDistance(OutlineField &field) {
+    const int w = field.width;
+    const int h = field.height;
+    std::vector<unsigned char> &d = field.distance;
+    d.assign((size_t)w * h, OUTLINE_DISTANCE_MAX);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (field.IsOutline(x, y)) d[y * w + x] = 0;
+
+    auto relax = [&](int idx, int nx, int ny) {
+        if (nx < 0 || nx >= w || ny < 0 || ny >= h) return;
+        int cand = d[ny * w + nx] + 1;
+        if (cand < d[idx]) d[idx] = (unsigned char)cand;
+    };
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int idx = y * w + x;
+            relax(idx, x - 1, y);
+            relax(idx, x - 1, y - 1);
+            relax(idx, x, y - 1);
+            relax(idx, x + 1, y - 1);
+        }
+    }
+    for (int y = h - 1; y >= 0; y--) {
+        for (int x = w - 1; x >= 0; x--) {
+            int idx = y * w + x;
+            relax(idx, x + 1, y);
+            relax(idx, x + 1, y + 1);
+            relax(idx, x, y + 1);
+            relax(idx, x - 1, y + 1);
+        }
+    }
+}
+
+// The usual outline rule: dark pixels, by luma, optionally only where the image is visible
+struct OutlineRule {
+    LumaRule luma;
+    int maxLuma;         // outline when luma <= maxLuma
+    bool requireVisible; // and alpha > 0
+
+    // Outline cache key; distinct from the plain thresholds used as keys before
+    uint32_t Key() const { return 0x10000u | (uint32_t)requireVisible << 9 | (uint32_t)luma << 8 | (uint32_t)maxLuma; }
+};
+
+// Visible/outline masks are in place; settle the fallback and build the distance field.
+// If the image has no outline pixels, every visible pixel is treated as outline (very
+// permissive fallback).
+static inline void FinishOutlineField(OutlineField &field) {
+    if (field.outline.count == 0) field.outline = field.visible;
+    field.outlinePixels = field.outline.count;
+    ComputeChessboardDistance(field);
+}
+
+// Build the outline field from raw image pixels with the vectorized mask kernels
+static inline OutlineField BuildOutlineField(const Color *pixels, int w, int h, const OutlineRule &rule) {
+    OutlineField field;
+    field.width = w;
+    field.height = h;
+    AlphaVisibleMask((const uint8_t *)pixels, w, h, field.visible);
+    LumaThresholdMask((const uint8_t *)pixels, w, h, rule.luma, rule.maxLuma, rule.requireVisible, field.outline);
+    FinishOutlineField(field);
+    return field;
+}
+
+// Same, for rules that don't fit OutlineRule: isOutline decides pixel by pixel
+template <typename IsOutlinePixel>
+OutlineField BuildOutlineField(const Color *pixels, int w, int h, IsOutlinePixel isOutline) {
+    OutlineField field;
+    field.width = w;
+    field.height = h;
+    AlphaVisibleMask((const uint8_t *)pixels, w, h, field.visible);
+    field.outline.Resize(w, h);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (isOutline(pixels[y * w + x])) field.outline.Set(x, y);
+    FinishOutlineField(field);
+    return field;
+}
+
+// Mark every outline pixel within radius (chessboard) of (x,y) in scratched; returns false if
+// there are none. The distance field answers "is there outline nearby" in one lookup, so misses
+// (the common case while cracking) cost nothing. A hit ORs the outline bits of the window into
+// the mask one 8x8 tile at a time.
+static inline bool ScratchOutlineNear(const OutlineField &field, int x, int y, int radius, TiledBitset &scratched) {
+    if (!field.IsNearOutline(x, y, radius)) return false;
+
+    field.outline.ForEachTileInRegion(x - radius, y - radius, x + radius, y + radius,
+                                      [&](int tile, uint64_t window) {
+        scratched.SetTileBits(tile, field.outline.tiles[tile] & window);
+    });
+    return true;
+}
+
+// Calls fn(x, y) for each pixel of the 8-connected Bresenham line from (x0,y0) to (x1,y1),
+// both ends included. Stamping a (2r+1)^2 window at every pixel sweeps the whole segment.
+template <typename Fn>
+static inline void ForEachStrokePixel(int x0, int y0, int x1, int y1, Fn fn) {
+    int dx = std::abs(x1 - x0), dy = -std::abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+        fn(x0, y0);
+        if (x0 == x1 && y0 == y1) return;
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+// Scratches along the stroke from the previous mouse sample to this one, so how much of the
+// outline a movement scratches no longer depends on how often it was sampled. hit: some
+// outline was in reach; missed: some point of the stroke on the cookie was not near any.
+// Points off the image are skipped, like a single sample there.
+struct StrokeScratch {
+    bool hit = false;
+    bool missed = false;
+};
+
+static inline StrokeScratch ScratchOutlineAlong(const OutlineField &field, int x0, int y0, int x1, int y1, int radius,
+                                                TiledBitset &scratched) {
+    StrokeScratch result;
+    ForEachStrokePixel(x0, y0, x1, y1, [&](int x, int y) {
+        if (!field.InBounds(x, y)) return;
+        if (field.IsVisible(x, y) && ScratchOutlineNear(field, x, y, radius, scratched)) result.hit = true;
+        else result.missed = true;
+    });
+    return result;
+}
@@ -1,5 +1,12 @@
 #include <raylib.h>
 #include <cstdio>
+#include "tiled_bitset.h"
+#include "outline_cache.h"
+#include "sim_clock.h"
+#include "game_input.h"
+#include "replay.h"
+#include "frame_pacer.h"
+#include "tournament_results.h"
 
 #ifndef DARKRED
 #define DARKRED CLITERAL(Color){139, 0, 0, 255}
@@ -8,42 +15,31 @@
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 
-// Only consider nearly-black pixels as "dark"
-bool IsDark(Color c, int threshold = 10) {
-    int avg = (c.r + c.g + c.b) / 3;
-    return avg < threshold;
-}
+// Only consider nearly-black pixels as "dark": channel average below 10, transparent or not
+const OutlineRule BOUNDARY_RULE = {LUMA_AVERAGE, 9, false};
 
-int main() {
+int main(int argc, char **argv) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Trace the Boundary");
     SetTargetFPS(60);
 
-    // Load images
-    Image boundaryImg = LoadImage("triangle_boundary.png"); // big black boundary
-    Image innerImg    = LoadImage("triangle.png");          // smaller bright triangle
+    // Dark boundary pixels as a bitmap, cached in triangle_boundary.png.outline
+    OutlineField boundary = LoadOrBuildOutlineField("triangle_boundary.png", BOUNDARY_RULE);
+
+    // Textures for drawing
+    Texture2D boundaryTex = LoadTexture("triangle_boundary.png"); // big black boundary
+    Texture2D innerTex    = LoadTexture("triangle.png");          // smaller bright triangle
 
-    if (!boundaryImg.data || !innerImg.data) {
+    if (boundary.width == 0 || boundaryTex.id == 0 || innerTex.id == 0) {
         printf("Error: could not load images.\n");
         CloseWindow();
         return -1;
     }
 
-    // Convert images to a known pixel format before pixel access
-    ImageFormat(&boundaryImg, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-    ImageFormat(&innerImg, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-
-    int imgWidth = boundaryImg.width;
-    int imgHeight = boundaryImg.height;
-
-    // Get pointer to boundary pixels
-    Color *boundaryPixels = LoadImageColors(boundaryImg);
+    int imgWidth = boundary.width;
+    int imgHeight = boundary.height;
 
-    // Allocate pixelVisited dynamically on the heap, initialized to false
-    bool* pixelVisited = new bool[imgWidth * imgHeight]();
-
-    // Textures for drawing
-    Texture2D boundaryTex = LoadTextureFromImage(boundaryImg);
-    Texture2D innerTex    = LoadTextureFromImage(innerImg);
+    // One bit per boundary pixel, packed in 8x8 tiles
+    TiledBitset pixelVisited(imgWidth, imgHeight);
 
     // Position images centered
     Vector2 boundaryPos = {
@@ -51,39 +47,60 @@ int main() {
         (SCREEN_HEIGHT - imgHeight) / 2.0f
     };
     Vector2 innerPos = {
-        (SCREEN_WIDTH - innerImg.width) / 2.0f,
-        (SCREEN_HEIGHT - innerImg.height) / 2.0f
+        (SCREEN_WIDTH - innerTex.width) / 2.0f,
+        (SCREEN_HEIGHT - innerTex.height) / 2.0f
     };
 
     int progressCount = 0;
     int crackCount = 0;
     const int maxCracks = 10;
 
+    InputLatch latch;
+    FixedStepClock clock;
+    ReplaySession replay;
+    replay.Start(argc, argv, REPLAY_DOLGANA); // no random elements; the seed is recorded for completeness
+    Pacer().Start(argc, argv);
+    TournamentResults results;
+    if (!replay.Replaying()) results.Open(ResultsPath(argc, argv));
+    replay.BeginSegment(REPLAY_DOLGANA);
+
+    // Each tick walks every pixel of the stroke since the previous tick's mouse position, so
+    // progress doesn't depend on how often the mouse was sampled
+    bool stroking = false;
+    int lastX = 0, lastY = 0;
     while (!WindowShouldClose()) {
-        bool isPressing = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
-        Vector2 mouse = GetMousePosition();
+        latch.Poll();
+        int steps = replay.StepsThisFrame(clock);
+        for (int s = 0; s < steps; s++) {
+            InputFrame in = replay.NextInput(latch);
+            bool isPressing = in.MouseDown();
+            Vector2 mouse = in.Mouse();
 
-        if (isPressing) {
             // Mouse relative to boundary image position
             int px = (int)(mouse.x - boundaryPos.x);
             int py = (int)(mouse.y - boundaryPos.y);
 
-            if (px >= 0 && px < imgWidth &&
-                py >= 0 && py < imgHeight) {
-
-                int idx = py * imgWidth + px;
-                if (!pixelVisited[idx]) {
-                    pixelVisited[idx] = true;
-                    Color underPixel = boundaryPixels[idx];
-                    if (IsDark(underPixel)) {
-                        progressCount++;
-                    } else {
-                        crackCount++;
-                    }
+            if (isPressing) {
+                if (!stroking) {
+                    lastX = px;
+                    lastY = py;
                 }
-            } else {
-                crackCount++;
+                ForEachStrokePixel(lastX, lastY, px, py, [&](int x, int y) {
+                    if (!boundary.InBounds(x, y)) return;
+                    if (pixelVisited.Set(x, y)) {
+                        if (boundary.IsOutline(x, y)) {
+                            progressCount++;
+                        } else {
+                            crackCount++;
+                        }
+                    }
+                });
+                if (!boundary.InBounds(px, py)) crackCount++;
             }
+            stroking = isPressing;
+            lastX = px;
+            lastY = py;
+            if ((float)progressCount / 200.0f >= 1.0f || crackCount >= maxCracks) break;
         }
 
         float progress = (float)progressCount / 200.0f; // adjust difficulty
@@ -106,11 +123,13 @@ int main() {
 
         EndDrawing();
 
-        if (progress >= 1.0f || crackCount >= maxCracks)
+        if (progress >= 1.0f || crackCount >= maxCracks) {
+            if (results.IsOpen()) results.Record(REPLAY_DOLGANA, RESULTS_DEFAULT_PLAYER, progress >= 1.0f ? RESULT_WON : RESULT_LOST);
             break;
+        }
     }
 
-    // End screen
+    // End screen: nothing changes, so sleep until the window is closed or disturbed
     while (!WindowShouldClose()) {
         BeginDrawing();
         ClearBackground(RAYWHITE);
@@ -118,16 +137,14 @@ int main() {
             DrawText("You Win!", SCREEN_WIDTH / 2 - 60, SCREEN_HEIGHT / 2 - 20, 40, DARKGREEN);
         else
             DrawText("You Lost!", SCREEN_WIDTH / 2 - 60, SCREEN_HEIGHT / 2 - 20, 40, DARKRED);
+        Pacer().Idle(IDLE_UNTIL_INPUT);
         EndDrawing();
     }
+    Pacer().Resume();
 
     // Cleanup
-    delete[] pixelVisited;
-    UnloadImageColors(boundaryPixels);
     UnloadTexture(boundaryTex);
     UnloadTexture(innerTex);
-    UnloadImage(boundaryImg);
-    UnloadImage(innerImg);
     CloseWindow();
 
     return 0;
@@ -0,0 +1,106 @@
+// Idle frame pacing
+// Every loop renders at SetTargetFPS(60), but a menu or a finished round draws the same picture
+// frame after frame. Right before EndDrawing() a loop tells the pacer how long its picture stays
+// unchanged if no input arrives. While that is non-zero the pacer turns on raylib's event
+// waiting, so EndDrawing() sleeps in the OS until a key, mouse or window event instead of
+// redrawing. A finite wait also arms a wake-up (an empty GLFW event posted from a timer thread)
+// so scripted pauses such as the marble AI's still end on time. --no-idle keeps the fixed rate;
+// building with -DSQUID_IDLE_WAKE=0 (a raylib without the GLFW backend) only idles untimed waits.
+#pragma once
+
+#ifndef SQUID_IDLE_WAKE
+#define SQUID_IDLE_WAKE 1
+#endif
+
+#include <raylib.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#if SQUID_IDLE_WAKE
+extern "C" void glfwPostEmptyEvent(void); // desktop raylib links GLFW in
+#endif
+
+const double IDLE_UNTIL_INPUT = std::numeric_limits<double>::infinity();
+
+class FramePacer {
+public:
+    ~FramePacer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            armed = false;
+        }
+        wake.notify_one();
+        if (timer.joinable()) timer.join();
+    }
+
+    void Start(int argc, char **argv) {
+        for (int i = 1; i < argc; i++)
+            if (!strcmp(argv[i], "--no-idle")) enabled = false;
+    }
+
+    // Once per frame, right before EndDrawing(): seconds the frame will look exactly as drawn
+    // if no input arrives. 0 redraws at the target rate; IDLE_UNTIL_INPUT waits for input only.
+    void Idle(double seconds) {
+        if (!enabled) seconds = 0.0;
+#if !SQUID_IDLE_WAKE
+        if (seconds != IDLE_UNTIL_INPUT) seconds = 0.0;
+#endif
+        bool wait = seconds > 0.0;
+        if (wait != waiting) {
+            if (wait) EnableEventWaiting();
+            else DisableEventWaiting();
+            waiting = wait;
+        }
+        ArmWake(wait && seconds != IDLE_UNTIL_INPUT ? seconds : 0.0);
+    }
+
+    // Back to the target rate; call when leaving a loop that may have idled
+    void Resume() { Idle(0.0); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void ArmWake(double seconds) {
+        std::lock_guard<std::mutex> lock(mutex);
+        armed = seconds > 0.0;
+        if (!armed) return; // a pending wake-up just expires unused
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        if (!timer.joinable()) timer = std::thread([this] { TimerLoop(); });
+        wake.notify_one();
+    }
+
+    void TimerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!quit) {
+            if (!armed) {
+                wake.wait(lock);
+            } else if (Clock::now() >= deadline) {
+                armed = false;
+#if SQUID_IDLE_WAKE
+                glfwPostEmptyEvent(); // ends the wait inside EndDrawing()
+#endif
+            } else {
+                wake.wait_until(lock, deadline);
+            }
+        }
+    }
+
+    bool enabled = true;
+    bool waiting = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread timer;
+    Clock::time_point deadline;
+    bool armed = false;
+    bool quit = false;
+};
+
+static inline FramePacer &Pacer() {
+    static FramePacer pacer;
+    return pacer;
+}
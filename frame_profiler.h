@@ -0,0 +1,263 @@
+// Frame profiler
+// Scoped CPU timers for the main loop's sections, submission counters and a frame-time
+// history. F3 toggles an overlay with a frame-time histogram, p50/p99 and per-section times;
+// --profile starts with it shown and --trace FILE writes every timed section as Chrome trace
+// JSON (chrome://tracing, Perfetto) on exit. Build with -DSQUID_PROFILE=0 to compile all of it
+// out: the PROFILE_* macros then expand to nothing.
+#pragma once
+
+#ifndef SQUID_PROFILE
+#define SQUID_PROFILE 1
+#endif
+
+#if SQUID_PROFILE
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+const int PROFILE_HISTORY = 240;          // frames kept for the histogram and percentiles
+const int PROFILE_MAX_ZONES = 24;         // distinct section names
+const int PROFILE_MAX_COUNTERS = 8;
+const int PROFILE_HISTOGRAM_BUCKETS = 34; // 1 ms each, the last one collects everything slower
+const size_t PROFILE_TRACE_MAX_EVENTS = 1 << 20;
+
+class FrameProfiler {
+public:
+    void Start(int argc, char **argv) {
+        for (int i = 1; i < argc; i++) {
+            if (!strcmp(argv[i], "--profile")) visible = true;
+            else if (!strcmp(argv[i], "--trace") && i + 1 < argc) tracePath = argv[++i];
+        }
+        if (tracePath) trace.reserve(1 << 16);
+        frameStart = Now();
+    }
+
+    // Section names must be string literals (they are compared by address)
+    void Begin(const char *name) {
+        if (depth < (int)(sizeof(stack) / sizeof(stack[0]))) stack[depth] = {FindZone(name, depth), name, Now()};
+        depth++;
+    }
+
+    void End() {
+        if (depth == 0) return;
+        depth--;
+        if (depth >= (int)(sizeof(stack) / sizeof(stack[0]))) return;
+        double end = Now();
+        const Open &open = stack[depth];
+        if (open.zone) open.zone->frameUs += end - open.start;
+        if (tracePath && trace.size() < PROFILE_TRACE_MAX_EVENTS)
+            trace.push_back({open.name, open.start, end - open.start});
+    }
+
+    void Count(const char *name, int n) {
+        for (int i = 0; i < counterCount; i++) {
+            if (counters[i].name == name) {
+                counters[i].frame += n;
+                return;
+            }
+        }
+        if (counterCount < PROFILE_MAX_COUNTERS) counters[counterCount++] = {name, n, 0};
+    }
+
+    // Once per rendered frame, inside BeginDrawing() right before EndDrawing(): closes the
+    // frame's statistics and draws the overlay if it is shown
+    void Frame() {
+        double now = Now();
+        double frameUs = now - frameStart;
+        if (tracePath && trace.size() < PROFILE_TRACE_MAX_EVENTS) trace.push_back({"frame", frameStart, frameUs});
+        frameStart = now;
+
+        frameMs[head] = (float)(frameUs / 1000.0);
+        for (int i = 0; i < zoneCount; i++) {
+            zones[i].ms[head] = (float)(zones[i].frameUs / 1000.0);
+            zones[i].frameUs = 0.0;
+        }
+        for (int i = 0; i < counterCount; i++) {
+            counters[i].last = counters[i].frame;
+            counters[i].frame = 0;
+        }
+        head = (head + 1) % PROFILE_HISTORY;
+        if (frames < PROFILE_HISTORY) frames++;
+
+        if (IsKeyPressed(KEY_F3)) visible = !visible;
+        if (visible) DrawOverlay();
+    }
+
+    // Writes the trace requested with --trace, if any
+    void Finish() {
+        if (!tracePath) return;
+        FILE *f = fopen(tracePath, "w");
+        if (!f) {
+            printf("Cannot write trace %s\n", tracePath);
+            return;
+        }
+        fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        for (size_t i = 0; i < trace.size(); i++) {
+            const TraceEvent &e = trace[i];
+            fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n", e.name,
+                    e.start, e.duration, i + 1 < trace.size() ? "," : "");
+        }
+        fprintf(f, "]}\n");
+        fclose(f);
+        printf("Wrote %zu trace events to %s%s\n", trace.size(), tracePath,
+               trace.size() >= PROFILE_TRACE_MAX_EVENTS ? " (truncated)" : "");
+        tracePath = nullptr;
+    }
+
+private:
+    struct Zone;
+    struct Open {
+        Zone *zone; // null once PROFILE_MAX_ZONES names are in use
+        const char *name;
+        double start;
+    };
+    struct Zone {
+        const char *name;
+        int depth;     // nesting level the first time it was seen, for indentation
+        double frameUs;
+        float ms[PROFILE_HISTORY];
+    };
+    struct Counter {
+        const char *name;
+        int frame;
+        int last;
+    };
+    struct TraceEvent {
+        const char *name;
+        double start;    // microseconds since the profiler started
+        double duration;
+    };
+
+    double Now() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    Zone *FindZone(const char *name, int zoneDepth) {
+        for (int i = 0; i < zoneCount; i++)
+            if (zones[i].name == name) return &zones[i];
+        if (zoneCount == PROFILE_MAX_ZONES) return nullptr;
+        Zone &z = zones[zoneCount++];
+        z.name = name;
+        z.depth = zoneDepth;
+        z.frameUs = 0.0;
+        std::fill(z.ms, z.ms + PROFILE_HISTORY, 0.0f);
+        return &z;
+    }
+
+    float Percentile(std::vector<float> &sorted, float p) const {
+        if (sorted.empty()) return 0.0f;
+        size_t i = (size_t)(p * (sorted.size() - 1) + 0.5f);
+        return sorted[i];
+    }
+
+    void DrawOverlay() {
+        const int w = 300;
+        const int lineH = 14;
+        const int histH = 60;
+        int h = 62 + histH + (zoneCount + counterCount) * lineH;
+        int x = GetScreenWidth() - w - 10;
+        int y = 10;
+        DrawRectangle(x, y, w, h, Fade(BLACK, 0.75f));
+
+        std::vector<float> sorted;
+        sorted.reserve(frames);
+        int buckets[PROFILE_HISTOGRAM_BUCKETS] = {};
+        for (int i = 0; i < frames; i++) {
+            float ms = frameMs[(head - 1 - i + PROFILE_HISTORY) % PROFILE_HISTORY];
+            sorted.push_back(ms);
+            buckets[std::min((int)ms, PROFILE_HISTOGRAM_BUCKETS - 1)]++;
+        }
+        std::sort(sorted.begin(), sorted.end());
+        DrawText(TextFormat("frame  p50 %.2f  p99 %.2f  max %.2f ms", Percentile(sorted, 0.5f),
+                            Percentile(sorted, 0.99f), sorted.empty() ? 0.0f : sorted.back()),
+                 x + 6, y + 6, 10, WHITE);
+
+        // Histogram of the last PROFILE_HISTORY frame times, 1 ms per bar
+        int top = y + 22;
+        int peak = std::max(1, *std::max_element(buckets, buckets + PROFILE_HISTOGRAM_BUCKETS));
+        int barW = (w - 12) / PROFILE_HISTOGRAM_BUCKETS;
+        for (int b = 0; b < PROFILE_HISTOGRAM_BUCKETS; b++) {
+            int barH = buckets[b] * histH / peak;
+            Color c = b < 17 ? GREEN : (b < 33 ? YELLOW : RED); // within 60 / 30 fps budgets
+            DrawRectangle(x + 6 + b * barW, top + histH - barH, barW - 1, barH, c);
+        }
+        DrawText("0", x + 6, top + histH + 2, 10, GRAY);
+        DrawText("16.7", x + 6 + 16 * barW, top + histH + 2, 10, GRAY);
+        DrawText(TextFormat("%d+ ms", PROFILE_HISTOGRAM_BUCKETS - 1), x + w - 44, top + histH + 2, 10, GRAY);
+
+        // Per-section CPU time: last frame, mean and worst over the history
+        int row = top + histH + 18;
+        DrawText("section            last   mean    max", x + 6, row, 10, LIGHTGRAY);
+        row += lineH;
+        for (int i = 0; i < zoneCount; i++) {
+            const Zone &z = zones[i];
+            float last = z.ms[(head - 1 + PROFILE_HISTORY) % PROFILE_HISTORY];
+            float sum = 0.0f, worst = 0.0f;
+            for (int f = 0; f < frames; f++) {
+                float ms = z.ms[(head - 1 - f + PROFILE_HISTORY) % PROFILE_HISTORY];
+                sum += ms;
+                worst = std::max(worst, ms);
+            }
+            DrawText(TextFormat("%*s%-*s %6.2f %6.2f %6.2f", z.depth * 2, "", 16 - z.depth * 2, z.name, last,
+                                frames ? sum / frames : 0.0f, worst),
+                     x + 6, row, 10, WHITE);
+            row += lineH;
+        }
+        for (int i = 0; i < counterCount; i++) {
+            DrawText(TextFormat("%-16s %6d / frame", counters[i].name, counters[i].last), x + 6, row, 10, SKYBLUE);
+            row += lineH;
+        }
+    }
+
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    double frameStart = 0.0;
+    Open stack[32];
+    int depth = 0;
+    Zone zones[PROFILE_MAX_ZONES];
+    int zoneCount = 0;
+    Counter counters[PROFILE_MAX_COUNTERS];
+    int counterCount = 0;
+    float frameMs[PROFILE_HISTORY] = {};
+    int head = 0;
+    int frames = 0;
+    bool visible = false;
+    const char *tracePath = nullptr;
+    std::vector<TraceEvent> trace;
+};
+
+static inline FrameProfiler &Profiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+struct ProfileScope {
+    explicit ProfileScope(const char *name) { Profiler().Begin(name); }
+    ~ProfileScope() { Profiler().End(); }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_START(argc, argv) Profiler().Start(argc, argv)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_BEGIN(name) Profiler().Begin(name)
+#define PROFILE_END() Profiler().End()
+#define PROFILE_COUNT(name, n) Profiler().Count(name, n)
+#define PROFILE_FRAME() Profiler().Frame()
+#define PROFILE_FINISH() Profiler().Finish()
+
+#else
+
+#define PROFILE_START(argc, argv) ((void)0)
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_COUNT(name, n) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_FINISH() ((void)0)
+
+#endif
@@ -0,0 +1,66 @@
+// Per-tick input
+// Raylib input is polled once per rendered frame into an InputLatch; each simulation tick then
+// consumes one InputFrame. Key presses are held until a tick consumes them, so a press is seen
+// by exactly one tick however many ticks a frame runs (including none).
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+#include <initializer_list>
+
+struct InputFrame {
+    uint32_t keysDown = 0;    // bit i: binding i is held
+    uint32_t keysPressed = 0; // bit i: binding i went down since the previous tick
+    int16_t mouseX = 0;
+    int16_t mouseY = 0;
+    uint8_t mouseDown = 0;    // bit per mouse button (left = bit 0)
+    uint8_t mousePressed = 0;
+
+    bool Down(int binding) const { return (keysDown >> binding) & 1; }
+    bool Pressed(int binding) const { return (keysPressed >> binding) & 1; }
+    bool MouseDown(int button = MOUSE_BUTTON_LEFT) const { return (mouseDown >> button) & 1; }
+    bool MousePressed(int button = MOUSE_BUTTON_LEFT) const { return (mousePressed >> button) & 1; }
+    Vector2 Mouse() const { return {(float)mouseX, (float)mouseY}; }
+};
+
+const int INPUT_MOUSE_BUTTONS = 3;
+
+class InputLatch {
+public:
+    InputLatch() = default;
+    // bindings[i] is the raylib key reported as bit i (up to 32 keys)
+    InputLatch(std::initializer_list<int> keys) : bindings(keys) {}
+    explicit InputLatch(const std::vector<int> &keys) : bindings(keys) {}
+
+    // Call once per rendered frame
+    void Poll() {
+        pending.keysDown = 0;
+        for (size_t i = 0; i < bindings.size(); i++) {
+            if (IsKeyDown(bindings[i])) pending.keysDown |= 1u << i;
+            if (IsKeyPressed(bindings[i])) pending.keysPressed |= 1u << i;
+        }
+        Vector2 mouse = GetMousePosition();
+        pending.mouseX = (int16_t)mouse.x;
+        pending.mouseY = (int16_t)mouse.y;
+        pending.mouseDown = 0;
+        for (int b = 0; b < INPUT_MOUSE_BUTTONS; b++) {
+            if (IsMouseButtonDown(b)) pending.mouseDown |= (uint8_t)(1 << b);
+            if (IsMouseButtonPressed(b)) pending.mousePressed |= (uint8_t)(1 << b);
+        }
+    }
+
+    // Latest polled state without consuming presses (for hover highlights and the like)
+    const InputFrame &Peek() const { return pending; }
+
+    // Call once per simulation tick
+    InputFrame Consume() {
+        InputFrame frame = pending;
+        pending.keysPressed = 0;
+        pending.mousePressed = 0;
+        return frame;
+    }
+
+private:
+    std::vector<int> bindings;
+    InputFrame pending;
+};
@@ -0,0 +1,212 @@
+// Image kernels
+// Whole-image passes over RGBA8 pixels (bytes R, G, B, A), 4-32 pixels per instruction with
+// SSE2/AVX2 when available and a scalar fallback: luma, luma thresholds and alpha coverage
+// written straight into TiledBitset tiles, and square (chessboard) dilation of 8-bit planes.
+// Thresholds compare integer weighted sums, so every path selects exactly the same pixels.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "tiled_bitset.h"
+
+enum LumaRule {
+    LUMA_REC709, // 0.2126 R + 0.7152 G + 0.0722 B
+    LUMA_AVERAGE // (R + G + B) / 3, rounded down
+};
+
+// Weighted sum per rule: 10000 x Rec.709 luma, or 3 x the average
+struct LumaWeights {
+    int r, g, b;
+};
+
+static inline LumaWeights WeightsOf(LumaRule rule) {
+    return rule == LUMA_REC709 ? LumaWeights{2126, 7152, 722} : LumaWeights{1, 1, 1};
+}
+
+// Largest weighted sum whose luma is still <= maxLuma
+static inline int32_t LumaSumLimit(LumaRule rule, int maxLuma) {
+    return rule == LUMA_REC709 ? 10000 * maxLuma : 3 * maxLuma + 2;
+}
+
+static inline int32_t LumaSum(const uint8_t *p, LumaWeights w) { return w.r * p[0] + w.g * p[1] + w.b * p[2]; }
+
+// ---------------------------
+// Per-8-pixel masks (one tile row)
+// ---------------------------
+
+// Bit i: pixel i has weighted sum <= limit (and alpha > 0 when requireAlpha)
+static inline uint32_t DarkBits8Scalar(const uint8_t *px, int n, LumaWeights w, int32_t limit, bool requireAlpha) {
+    uint32_t bits = 0;
+    for (int i = 0; i < n; i++, px += 4)
+        if (LumaSum(px, w) <= limit && (!requireAlpha || px[3] > 0)) bits |= 1u << i;
+    return bits;
+}
+
+static inline uint32_t AlphaBits8Scalar(const uint8_t *px, int n) {
+    uint32_t bits = 0;
+    for (int i = 0; i < n; i++) bits |= (uint32_t)(px[4 * i + 3] > 0) << i;
+    return bits;
+}
+
+#if defined(__AVX2__)
+// The sums come from two madds: (R, B) and (G, A) each form a pair of 16-bit halves per pixel
+static inline uint32_t DarkBits8(const uint8_t *px, LumaWeights w, int32_t limit, bool requireAlpha) {
+    const __m256i low = _mm256_set1_epi32(0x00FF00FF);
+    __m256i p = _mm256_loadu_si256((const __m256i *)px);
+    __m256i rb = _mm256_and_si256(p, low);
+    __m256i ga = _mm256_and_si256(_mm256_srli_epi32(p, 8), low);
+    __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(rb, _mm256_set1_epi32(w.b << 16 | w.r)),
+                                   _mm256_madd_epi16(ga, _mm256_set1_epi32(w.g)));
+    uint32_t bits = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(limit + 1), sum)));
+    if (requireAlpha) bits &= ~(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(
+                                 _mm256_cmpeq_epi32(_mm256_srli_epi32(p, 24), _mm256_setzero_si256())));
+    return bits & 0xFF;
+}
+
+static inline uint32_t AlphaBits8(const uint8_t *px) {
+    __m256i a = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *)px), 24);
+    return ~(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()))) & 0xFF;
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+static inline uint32_t DarkBits8(const uint8_t *px, LumaWeights w, int32_t limit, bool requireAlpha) {
+    const __m128i low = _mm_set1_epi32(0x00FF00FF);
+    const __m128i wrb = _mm_set1_epi32(w.b << 16 | w.r), wg = _mm_set1_epi32(w.g);
+    const __m128i bound = _mm_set1_epi32(limit + 1);
+    uint32_t bits = 0;
+    for (int half = 0; half < 2; half++) {
+        __m128i p = _mm_loadu_si128((const __m128i *)(px + 16 * half));
+        __m128i rb = _mm_and_si128(p, low);
+        __m128i ga = _mm_and_si128(_mm_srli_epi32(p, 8), low);
+        __m128i sum = _mm_add_epi32(_mm_madd_epi16(rb, wrb), _mm_madd_epi16(ga, wg));
+        uint32_t dark = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(bound, sum)));
+        if (requireAlpha)
+            dark &= ~(uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_srli_epi32(p, 24), _mm_setzero_si128())));
+        bits |= (dark & 0xF) << (4 * half);
+    }
+    return bits;
+}
+
+static inline uint32_t AlphaBits8(const uint8_t *px) {
+    uint32_t zero = 0;
+    for (int half = 0; half < 2; half++) {
+        __m128i a = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(px + 16 * half)), 24);
+        zero |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, _mm_setzero_si128()))) << (4 * half);
+    }
+    return ~zero & 0xFF;
+}
+#else
+static inline uint32_t DarkBits8(const uint8_t *px, LumaWeights w, int32_t limit, bool requireAlpha) {
+    return DarkBits8Scalar(px, 8, w, limit, requireAlpha);
+}
+
+static inline uint32_t AlphaBits8(const uint8_t *px) { return AlphaBits8Scalar(px, 8); }
+#endif
+
+// Fills out (resized to w x h) tile row by tile row: full 8-pixel runs go through bits8,
+// the ragged right edge through tail(px, n)
+template <typename Bits8, typename Tail>
+static inline void BuildTiledMask(const uint8_t *rgba, int w, int h, TiledBitset &out, Bits8 bits8, Tail tail) {
+    out.Resize(w, h);
+    const int fullTiles = w / TILE_SIZE;
+    for (int y = 0; y < h; y++) {
+        const uint8_t *row = rgba + (size_t)4 * w * y;
+        uint64_t *tiles = &out.tiles[(size_t)(y / TILE_SIZE) * out.tilesX];
+        const int shift = (y % TILE_SIZE) * TILE_SIZE;
+        for (int tx = 0; tx < fullTiles; tx++) tiles[tx] |= (uint64_t)bits8(row + 4 * TILE_SIZE * tx) << shift;
+        if (fullTiles < out.tilesX)
+            tiles[fullTiles] |= (uint64_t)tail(row + 4 * TILE_SIZE * fullTiles, w - TILE_SIZE * fullTiles) << shift;
+    }
+    out.Recount();
+}
+
+// ---------------------------
+// Whole images
+// ---------------------------
+
+// Pixels whose luma is <= maxLuma (and that are visible, if requireVisible)
+static inline void LumaThresholdMask(const uint8_t *rgba, int w, int h, LumaRule rule, int maxLuma,
+                                     bool requireVisible, TiledBitset &out) {
+    const LumaWeights weights = WeightsOf(rule);
+    const int32_t limit = LumaSumLimit(rule, maxLuma);
+    BuildTiledMask(rgba, w, h, out,
+                   [&](const uint8_t *px) { return DarkBits8(px, weights, limit, requireVisible); },
+                   [&](const uint8_t *px, int n) { return DarkBits8Scalar(px, n, weights, limit, requireVisible); });
+}
+
+// Pixels with alpha > 0
+static inline void AlphaVisibleMask(const uint8_t *rgba, int w, int h, TiledBitset &out) {
+    BuildTiledMask(rgba, w, h, out, [](const uint8_t *px) { return AlphaBits8(px); },
+                   [](const uint8_t *px, int n) { return AlphaBits8Scalar(px, n); });
+}
+
+// 8-bit luma of n pixels. Rec.709 uses 8-bit fixed-point weights (54, 183, 19) / 256, rounded;
+// the average is exact. For display and analysis; thresholds use LumaThresholdMask.
+static inline void RgbaToLuma(const uint8_t *rgba, size_t n, LumaRule rule, uint8_t *luma) {
+    const bool rec709 = rule == LUMA_REC709;
+    const LumaWeights w = rec709 ? LumaWeights{54, 183, 19} : LumaWeights{1, 1, 1};
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i low = _mm_set1_epi32(0x00FF00FF);
+    const __m128i wrb = _mm_set1_epi32(w.b << 16 | w.r), wg = _mm_set1_epi32(w.g);
+    auto four = [&](const uint8_t *px) {
+        __m128i p = _mm_loadu_si128((const __m128i *)px);
+        __m128i sum = _mm_add_epi32(_mm_madd_epi16(_mm_and_si128(p, low), wrb),
+                                    _mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(p, 8), low), wg));
+        // Rec.709: (sum + 128) / 256. Average: sum / 3 as (sum * 21846) >> 16, exact for sum <= 765.
+        if (rec709) return _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(128)), 8);
+        return _mm_srli_epi32(_mm_madd_epi16(sum, _mm_set1_epi32(21846)), 16);
+    };
+    for (; i + 8 <= n; i += 8) {
+        __m128i y = _mm_packs_epi32(four(rgba + 4 * i), four(rgba + 4 * i + 16));
+        _mm_storel_epi64((__m128i *)(luma + i), _mm_packus_epi16(y, y));
+    }
+#endif
+    for (; i < n; i++) {
+        int sum = LumaSum(rgba + 4 * i, w);
+        luma[i] = (uint8_t)(rec709 ? (sum + 128) >> 8 : sum / 3);
+    }
+}
+
+// dst[i] = max(dst[i], src[i])
+static inline void MaxBytes(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32)
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_max_epu8(_mm256_loadu_si256((const __m256i *)(dst + i)),
+                                                                  _mm256_loadu_si256((const __m256i *)(src + i))));
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= n; i += 16)
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_max_epu8(_mm_loadu_si128((const __m128i *)(dst + i)),
+                                                            _mm_loadu_si128((const __m128i *)(src + i))));
+#endif
+    for (; i < n; i++) dst[i] = std::max(dst[i], src[i]);
+}
+
+// Square dilation of an 8-bit plane (coverage, alpha, or a 0/255 mask) by radius, grown on
+// every side: dst is (w + 2r) x (h + 2r) and dst(x, y) is the max of src over
+// [x - 2r, x] x [y - 2r, y]. Separable: a horizontal then a vertical running max.
+static inline void DilateMax8(const uint8_t *src, int w, int h, int radius, uint8_t *dst) {
+    const int r2 = 2 * radius, ow = w + r2, oh = h + r2;
+    std::vector<uint8_t> padded((size_t)w + 2 * r2, 0), rows((size_t)ow * h);
+    for (int y = 0; y < h; y++) {
+        memcpy(&padded[r2], src + (size_t)w * y, w);
+        uint8_t *out = &rows[(size_t)ow * y];
+        memcpy(out, padded.data(), ow);
+        for (int k = 1; k <= r2; k++) MaxBytes(out, &padded[k], ow);
+    }
+    for (int y = 0; y < oh; y++) {
+        uint8_t *out = dst + (size_t)ow * y;
+        memset(out, 0, ow);
+        for (int sy = std::max(0, y - r2); sy <= std::min(h - 1, y); sy++) MaxBytes(out, &rows[(size_t)ow * sy], ow);
+    }
+}
@@ -0,0 +1,181 @@
+// Memory-mapped files
+// MappedAppendFile grows a file in large chunks and appends by memcpy into the mapping, so
+// writing a few bytes per tick never hits a syscall. MappedReadFile maps a whole file
+// read-only. Platforms without mmap fall back to plain stdio.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SQUID_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedAppendFile {
+public:
+    static const size_t GROW_BYTES = 1 << 20; // mapping grows 1 MB at a time
+
+    MappedAppendFile() = default;
+    ~MappedAppendFile() { Close(); }
+    MappedAppendFile(const MappedAppendFile &) = delete;
+    MappedAppendFile &operator=(const MappedAppendFile &) = delete;
+
+    bool Open(const char *path) {
+        Close();
+#ifdef SQUID_HAS_MMAP
+        fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        return Reserve(GROW_BYTES);
+#else
+        file = fopen(path, "wb");
+        return file != nullptr;
+#endif
+    }
+
+    bool IsOpen() const {
+#ifdef SQUID_HAS_MMAP
+        return fd >= 0;
+#else
+        return file != nullptr;
+#endif
+    }
+
+    // A failed write (disk full, quota) closes the file, keeping what was written before it;
+    // later appends are then no-ops
+    void Append(const void *data, size_t bytes) {
+        if (!IsOpen()) return;
+#ifdef SQUID_HAS_MMAP
+        if (size + bytes > capacity && !Reserve(std::max(capacity * 2, size + bytes))) return;
+        memcpy(base + size, data, bytes);
+#else
+        if (fwrite(data, 1, bytes, file) != bytes) {
+            perror("fwrite");
+            Close();
+            return;
+        }
+#endif
+        size += bytes;
+    }
+
+    size_t Size() const { return size; }
+
+    // Trims the file to what was written
+    void Close() {
+#ifdef SQUID_HAS_MMAP
+        if (fd < 0) return;
+        if (base) munmap(base, capacity);
+        if (ftruncate(fd, (off_t)size) != 0) perror("ftruncate");
+        close(fd);
+        fd = -1;
+        base = nullptr;
+        capacity = 0;
+#else
+        if (file) fclose(file);
+        file = nullptr;
+#endif
+        size = 0;
+    }
+
+private:
+#ifdef SQUID_HAS_MMAP
+    // On failure the file is closed (see Append)
+    bool Reserve(size_t bytes) {
+        bytes = (bytes + GROW_BYTES - 1) / GROW_BYTES * GROW_BYTES;
+        if (base) munmap(base, capacity);
+        base = nullptr;
+        capacity = 0;
+        void *p = MAP_FAILED;
+        if (ftruncate(fd, (off_t)bytes) == 0) p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            perror("mapped file grow");
+            Close();
+            return false;
+        }
+        base = (uint8_t *)p;
+        capacity = bytes;
+        return true;
+    }
+
+    int fd = -1;
+    uint8_t *base = nullptr;
+    size_t capacity = 0;
+#else
+    FILE *file = nullptr;
+#endif
+    size_t size = 0;
+};
+
+class MappedReadFile {
+public:
+    MappedReadFile() = default;
+    ~MappedReadFile() { Close(); }
+    MappedReadFile(const MappedReadFile &) = delete;
+    MappedReadFile &operator=(const MappedReadFile &) = delete;
+
+    bool Open(const char *path) {
+        Close();
+#ifdef SQUID_HAS_MMAP
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        if (st.st_size == 0) {
+            close(fd);
+            return true; // empty: nothing to map
+        }
+        void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return false;
+        mapped = (const uint8_t *)p;
+        size = (size_t)st.st_size;
+        return true;
+#else
+        FILE *f = fopen(path, "rb");
+        if (!f) return false;
+        fseek(f, 0, SEEK_END);
+        long length = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        copy.resize(length > 0 ? (size_t)length : 0);
+        size = fread(copy.data(), 1, copy.size(), f);
+        fclose(f);
+        return true;
+#endif
+    }
+
+    const uint8_t *Data() const {
+#ifdef SQUID_HAS_MMAP
+        return mapped;
+#else
+        return copy.data();
+#endif
+    }
+    size_t Size() const { return size; }
+
+    void Close() {
+#ifdef SQUID_HAS_MMAP
+        if (mapped) munmap((void *)mapped, size);
+        mapped = nullptr;
+#else
+        copy.clear();
+#endif
+        size = 0;
+    }
+
+private:
+#ifdef SQUID_HAS_MMAP
+    const uint8_t *mapped = nullptr;
+#else
+    std::vector<uint8_t> copy;
+#endif
+    size_t size = 0;
+};
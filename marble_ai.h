@@ -0,0 +1,377 @@
+// Marble AI strategies
+// The odd-or-even game with no drawing, seen from two seats. The challenger (the human in
+// MarbleScene) guesses the parity of the house's hidden marbles and stakes a bet on it, then
+// hides marbles of its own, and that count is the stake of the house's guess. The house (the
+// scene's AI) hides a parity and guesses. A MarbleStrategy can sit in either seat. Strategies
+// see the opponent's moves through ParityHistory, which updates counts in O(1) per move, so
+// no decision rescans the game.
+//
+// PlayMarbleGame plays one game between two strategies with no window, for marble_arena's
+// self-play tournaments.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "sim_random.h"
+
+const int MARBLE_START = 10;  // marbles each side starts with
+const int MARBLE_MAX_PUT = 5; // most marbles hidden or bet in one turn
+
+enum MarbleSeat { SEAT_CHALLENGER, SEAT_HOUSE };
+
+struct MarbleView {
+    MarbleSeat seat;
+    int mine;   // marbles held
+    int theirs;
+};
+
+// Parities of one kind of opponent move, with counts after each short context
+struct ParityHistory {
+    int count[2];     // [parity]: 0 even, 1 odd
+    int after1[3][2]; // [previous parity, 2 = none][parity]
+    int after2[9][2]; // [two previous parities, 3 * older + newer][parity]
+    int last, beforeLast;
+
+    ParityHistory() { Clear(); }
+
+    void Clear() {
+        memset(count, 0, sizeof(count));
+        memset(after1, 0, sizeof(after1));
+        memset(after2, 0, sizeof(after2));
+        last = beforeLast = 2;
+    }
+
+    void Push(int parity) {
+        count[parity]++;
+        after1[last][parity]++;
+        after2[3 * beforeLast + last][parity]++;
+        beforeLast = last;
+        last = parity;
+    }
+
+    int Total() const { return count[0] + count[1]; }
+
+    // Chance the next move is odd: the longest context seen often enough, Laplace-smoothed
+    double PredictOdd(int minSeen = 3) const {
+        const int *ctx = after2[3 * beforeLast + last];
+        if (ctx[0] + ctx[1] < minSeen) ctx = after1[last];
+        if (ctx[0] + ctx[1] < minSeen) ctx = count;
+        return (ctx[1] + 1.0) / (ctx[0] + ctx[1] + 2.0);
+    }
+};
+
+// Uniform count in [1, maxPut] with the wanted parity, if there is one
+static inline int MarblesWithParity(bool odd, int maxPut, Pcg32 &rng) {
+    int choices = odd ? (maxPut + 1) / 2 : maxPut / 2;
+    if (choices == 0) return 1;
+    return 2 * (int)rng.Range(choices) + (odd ? 1 : 2);
+}
+
+class MarbleStrategy {
+public:
+    virtual ~MarbleStrategy() {}
+    virtual const char *Name() const = 0;
+
+    void NewGame() {
+        hides.Clear();
+        guesses.Clear();
+        Reset();
+    }
+
+    // The opponent revealed how many marbles it hid / guessed whether mine were odd
+    void ObserveHide(int marbles) { hides.Push(marbles & 1); }
+    void ObserveGuess(bool guessedOdd) { guesses.Push(guessedOdd ? 1 : 0); }
+
+    // Whether the opponent's hidden marbles are odd
+    virtual bool GuessOdd(const MarbleView &view, Pcg32 &rng) = 0;
+    // Marbles to hide, 1..maxPut. The challenger's count is the stake; the house's only shows parity.
+    virtual int Hide(const MarbleView &view, int maxPut, Pcg32 &rng) = 0;
+    // Challenger only, right after GuessOdd: the stake of that guess, 1..maxBet
+    virtual int Bet(const MarbleView &, int maxBet, Pcg32 &rng) { return (int)rng.Range(maxBet) + 1; }
+
+protected:
+    virtual void Reset() {}
+
+    ParityHistory hides;   // parities the opponent hid
+    ParityHistory guesses; // parities the opponent guessed for mine
+};
+
+// ---------------------------
+// Strategies
+// ---------------------------
+
+// Coin flips and uniform counts
+class RandomStrategy : public MarbleStrategy {
+public:
+    const char *Name() const override { return "random"; }
+    bool GuessOdd(const MarbleView &, Pcg32 &rng) override { return rng.Range(2) == 0; }
+    int Hide(const MarbleView &, int maxPut, Pcg32 &rng) override { return (int)rng.Range(maxPut) + 1; }
+};
+
+// The original AI: guess the parity the opponent hid most often (ties odd), hide 1-5 at random.
+// Draws exactly what the old PlayerAI drew, so marble replays recorded with it still play back.
+class ClassicStrategy : public MarbleStrategy {
+public:
+    const char *Name() const override { return "classic"; }
+    bool GuessOdd(const MarbleView &, Pcg32 &rng) override {
+        if (hides.Total() == 0) return rng.Range(2) == 0;
+        return hides.count[1] >= hides.count[0];
+    }
+    int Hide(const MarbleView &, int maxPut, Pcg32 &rng) override {
+        return std::min(maxPut, (int)rng.Range(MARBLE_MAX_PUT) + 1);
+    }
+};
+
+// Predicts the opponent's next parity from what followed the last two moves (falling back to
+// one move, then overall frequency). It plays the prediction only when it is clearly better
+// than a coin, so a patternless opponent faces a fair coin and cannot exploit it.
+class MarkovStrategy : public MarbleStrategy {
+public:
+    const char *Name() const override { return "markov"; }
+
+    bool GuessOdd(const MarbleView &, Pcg32 &rng) override {
+        double odd = hides.PredictOdd();
+        edge = std::fabs(odd - 0.5);
+        if (edge < CONFIDENT) return rng.Range(2) == 0;
+        return odd > 0.5;
+    }
+
+    // Hide the parity the opponent is least likely to guess
+    int Hide(const MarbleView &view, int maxPut, Pcg32 &rng) override {
+        double guessOdd = guesses.PredictOdd();
+        bool odd = std::fabs(guessOdd - 0.5) < CONFIDENT ? rng.Range(2) == 0 : guessOdd < 0.5;
+        if (view.seat == SEAT_CHALLENGER) {
+            // The count is the stake: risk little unless the opponent's guess is predictable
+            int stake = std::fabs(guessOdd - 0.5) < CONFIDENT ? std::min(maxPut, 2) : maxPut;
+            if ((stake & 1) != (odd ? 1 : 0)) stake = stake > 1 ? stake - 1 : stake;
+            return stake;
+        }
+        return MarblesWithParity(odd, maxPut, rng);
+    }
+
+    int Bet(const MarbleView &, int maxBet, Pcg32 &) override { return edge < CONFIDENT ? 1 : maxBet; }
+
+private:
+    static constexpr double CONFIDENT = 0.15; // |P(odd) - 1/2| before a prediction is trusted
+    double edge = 0.0;
+};
+
+// Plays the game's equilibrium, solved once per marble total. The state is the house's marble
+// count and whose turn it is; the value is the house's chance to win the game. Each turn is a
+// small zero-sum matrix game (the house picks a parity, the challenger a parity and stake or a
+// count to hide) over the values of the states it leads to. Value iteration over those turns
+// converges to optimal mixed strategies. It exploits nothing, but nothing exploits it.
+// The scene's once-per-game double bet is not modelled. Solved tables are shared by every
+// instance and thread.
+class EquilibriumStrategy : public MarbleStrategy {
+public:
+    const char *Name() const override { return "equilibrium"; }
+
+    bool GuessOdd(const MarbleView &view, Pcg32 &rng) override {
+        int house = Prepare(view);
+        if (view.seat == SEAT_HOUSE) return rng.NextFloat() < table->houseTurn[house].houseOdd;
+        // Challenger's turn: rows are (guess odd, bet 1..n) then (guess even, bet 1..n)
+        int n = std::min(MARBLE_MAX_PUT, view.mine);
+        int row = table->challengerTurn[house].Sample(rng);
+        pendingBet = row % n + 1;
+        return row < n;
+    }
+
+    int Hide(const MarbleView &view, int maxPut, Pcg32 &rng) override {
+        int house = Prepare(view);
+        if (view.seat == SEAT_HOUSE)
+            return MarblesWithParity(rng.NextFloat() < table->challengerTurn[house].houseOdd, maxPut, rng);
+        return std::min(maxPut, table->houseTurn[house].Sample(rng) + 1); // rows are counts 1..n
+    }
+
+    int Bet(const MarbleView &, int maxBet, Pcg32 &) override { return std::min(pendingBet, maxBet); }
+
+private:
+    struct Turn {
+        float houseOdd = 0.5f;     // chance the house picks odd (hides odd / guesses odd)
+        int rowA = 0, rowB = 0;    // challenger's equilibrium: rowA with weight, else rowB
+        float weightA = 1.0f;
+        double value = 0.5;
+
+        int Sample(Pcg32 &rng) const { return rng.NextFloat() < weightA ? rowA : rowB; }
+    };
+
+    struct Table {
+        std::vector<Turn> challengerTurn; // [house marbles]: the challenger guesses
+        std::vector<Turn> houseTurn;      // [house marbles]: the house guesses
+    };
+
+    // House (column player, odd or even) maximizes min over challenger rows of its win chance.
+    // Concave and piecewise linear in P(odd), so the optimum is an endpoint or a crossing.
+    static Turn SolveTurn(const std::vector<double> &ifOdd, const std::vector<double> &ifEven, bool canEven) {
+        const int rows = (int)ifOdd.size();
+        auto worst = [&](double q) {
+            double v = 1e9;
+            for (int i = 0; i < rows; i++) v = std::min(v, q * ifOdd[i] + (1 - q) * ifEven[i]);
+            return v;
+        };
+        double bestQ = 1.0, best = worst(1.0);
+        if (canEven) {
+            auto consider = [&](double q) {
+                double v = worst(q);
+                if (v > best + 1e-12) best = v, bestQ = q;
+            };
+            consider(0.0);
+            for (int i = 0; i < rows; i++)
+                for (int k = i + 1; k < rows; k++) {
+                    double di = ifOdd[i] - ifEven[i], dk = ifOdd[k] - ifEven[k];
+                    if (di == dk) continue;
+                    double q = (ifEven[k] - ifEven[i]) / (di - dk);
+                    if (q > 0.0 && q < 1.0) consider(q);
+                }
+        }
+
+        // Challenger: an active row with no slope, else two with opposite slopes mixed to a
+        // flat line, else (at an endpoint) the active row sloping the right way
+        Turn t;
+        t.houseOdd = (float)bestQ;
+        t.value = best;
+        int flat = -1, up = -1, down = -1;
+        for (int i = 0; i < rows; i++) {
+            if (std::fabs(bestQ * ifOdd[i] + (1 - bestQ) * ifEven[i] - best) > 1e-9) continue;
+            double slope = ifOdd[i] - ifEven[i];
+            if (std::fabs(slope) < 1e-12) flat = flat < 0 ? i : flat;
+            else if (slope > 0) up = up < 0 ? i : up;
+            else down = down < 0 ? i : down;
+        }
+        if (flat >= 0) {
+            t.rowA = t.rowB = flat;
+        } else if (up >= 0 && down >= 0 && bestQ > 0.0 && bestQ < 1.0) {
+            double su = ifOdd[up] - ifEven[up], sd = ifOdd[down] - ifEven[down];
+            t.rowA = up;
+            t.rowB = down;
+            t.weightA = (float)(-sd / (su - sd));
+        } else {
+            t.rowA = t.rowB = bestQ >= 1.0 ? (up >= 0 ? up : down) : (down >= 0 ? down : up);
+        }
+        return t;
+    }
+
+    static Table Solve(int total) {
+        Table t;
+        std::vector<Turn> &challengerTurn = t.challengerTurn, &houseTurn = t.houseTurn;
+        challengerTurn.assign(total + 1, Turn());
+        houseTurn.assign(total + 1, Turn());
+        auto win = [&](const std::vector<Turn> &next, int h) {
+            return h <= 0 ? 0.0 : h >= total ? 1.0 : next[h].value;
+        };
+        std::vector<double> ifOdd, ifEven;
+        for (int iteration = 0; iteration < 2000; iteration++) {
+            double change = 0.0;
+            for (int h = 1; h < total; h++) {
+                int n = std::min(MARBLE_MAX_PUT, total - h);
+                // Challenger guesses and bets b: right (same parity as the house) takes b
+                ifOdd.clear();
+                ifEven.clear();
+                for (int g = 0; g < 2; g++)
+                    for (int b = 1; b <= n; b++) {
+                        ifOdd.push_back(win(houseTurn, g == 0 ? h - b : h + b));
+                        ifEven.push_back(win(houseTurn, g == 1 ? h - b : h + b));
+                    }
+                Turn c = SolveTurn(ifOdd, ifEven, h >= 2);
+                // Challenger hides a: the house takes a if its guess matches the parity
+                ifOdd.clear();
+                ifEven.clear();
+                for (int a = 1; a <= n; a++) {
+                    ifOdd.push_back(win(challengerTurn, a & 1 ? h + a : h - a));
+                    ifEven.push_back(win(challengerTurn, a & 1 ? h - a : h + a));
+                }
+                Turn g = SolveTurn(ifOdd, ifEven, true);
+                change = std::max(change, std::fabs(c.value - challengerTurn[h].value));
+                change = std::max(change, std::fabs(g.value - houseTurn[h].value));
+                challengerTurn[h] = c;
+                houseTurn[h] = g;
+            }
+            if (change < 1e-10) break;
+        }
+        return t;
+    }
+
+    // Looks up (solving once per process) the table for the view's marble total; returns the
+    // house's marble count
+    int Prepare(const MarbleView &view) {
+        int total = view.mine + view.theirs;
+        if (!table || (int)table->houseTurn.size() != total + 1) {
+            static std::mutex mutex;
+            static std::map<int, Table> solved;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = solved.find(total);
+            if (it == solved.end()) it = solved.emplace(total, Solve(total)).first;
+            table = &it->second;
+        }
+        int house = view.seat == SEAT_HOUSE ? view.mine : view.theirs;
+        return std::max(1, std::min(house, total - 1));
+    }
+
+    const Table *table = nullptr;
+    int pendingBet = 1;
+};
+
+const char *const MARBLE_STRATEGIES[] = {"random", "classic", "markov", "equilibrium"};
+const int MARBLE_STRATEGY_COUNT = sizeof(MARBLE_STRATEGIES) / sizeof(MARBLE_STRATEGIES[0]);
+const char *const MARBLE_DEFAULT_STRATEGY = "markov";
+const char *const MARBLE_LEGACY_STRATEGY = "classic"; // the AI before strategies were pluggable
+
+// Null for an unknown name
+static inline std::unique_ptr<MarbleStrategy> MakeMarbleStrategy(const char *name) {
+    if (!strcmp(name, "random")) return std::unique_ptr<MarbleStrategy>(new RandomStrategy());
+    if (!strcmp(name, "classic")) return std::unique_ptr<MarbleStrategy>(new ClassicStrategy());
+    if (!strcmp(name, "markov")) return std::unique_ptr<MarbleStrategy>(new MarkovStrategy());
+    if (!strcmp(name, "equilibrium")) return std::unique_ptr<MarbleStrategy>(new EquilibriumStrategy());
+    return nullptr;
+}
+
+// --marble-ai NAME picks the house strategy
+static inline const char *MarbleStrategyName(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (!strcmp(argv[i], "--marble-ai")) return argv[i + 1];
+    return MARBLE_DEFAULT_STRATEGY;
+}
+
+// ---------------------------
+// Self-play
+// ---------------------------
+
+enum MarbleWinner { MARBLE_DRAW, MARBLE_CHALLENGER_WON, MARBLE_HOUSE_WON };
+
+// One game with the scene's turn order: the challenger guesses and bets, then hides. Games that
+// run past maxTurns turns are draws.
+static inline MarbleWinner PlayMarbleGame(MarbleStrategy &challenger, MarbleStrategy &house, Pcg32 &rng,
+                                          int maxTurns = 1000) {
+    int c = MARBLE_START, h = MARBLE_START;
+    challenger.NewGame();
+    house.NewGame();
+    for (int turn = 0; turn < maxTurns; turn++) {
+        MarbleView cv = {SEAT_CHALLENGER, c, h}, hv = {SEAT_HOUSE, h, c};
+        if (turn % 2 == 0) {
+            bool guessOdd = challenger.GuessOdd(cv, rng);
+            int bet = challenger.Bet(cv, std::min(MARBLE_MAX_PUT, c), rng);
+            int hidden = house.Hide(hv, std::min(MARBLE_MAX_PUT, h), rng);
+            house.ObserveGuess(guessOdd);
+            challenger.ObserveHide(hidden);
+            int won = guessOdd == ((hidden & 1) != 0) ? bet : -bet;
+            c += won;
+            h -= won;
+        } else {
+            int stake = challenger.Hide(cv, std::min(MARBLE_MAX_PUT, c), rng);
+            bool guessOdd = house.GuessOdd(hv, rng);
+            house.ObserveHide(stake);
+            challenger.ObserveGuess(guessOdd);
+            int won = guessOdd == ((stake & 1) != 0) ? stake : -stake;
+            h += won;
+            c -= won;
+        }
+        if (c <= 0) return MARBLE_HOUSE_WON;
+        if (h <= 0) return MARBLE_CHALLENGER_WON;
+    }
+    return MARBLE_DRAW;
+}
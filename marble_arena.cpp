@@ -0,0 +1,139 @@
+// Headless marble self-play tournament
+// Every strategy in marble_ai.h plays every other one (and itself) from both seats, many games
+// per pairing, and the table ranks them by their average win rate against the others.
+//
+//   g++ -std=c++17 -O2 -pthread marble_arena.cpp -o marble_arena
+//   ./marble_arena --games 1000000 --threads 0
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "marble_ai.h"
+#include "tick_scheduler.h"
+
+const long long ARENA_CHUNK_GAMES = 4096; // games per scheduler chunk
+
+struct PairingResult {
+    long long challengerWins = 0;
+    long long houseWins = 0;
+    long long draws = 0;
+};
+
+int main(int argc, char **argv) {
+    long long games = 100000; // per ordered pairing
+    int threads = 1;
+    int maxTurns = 1000;
+    uint64_t seed = 456;
+    std::vector<std::string> names(MARBLE_STRATEGIES, MARBLE_STRATEGIES + MARBLE_STRATEGY_COUNT);
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--games") && hasValue) games = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && hasValue) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--turns") && hasValue) maxTurns = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--strategies") && hasValue) {
+            names.clear();
+            std::string list = argv[++i];
+            for (size_t start = 0, comma; start <= list.size(); start = comma + 1) {
+                comma = list.find(',', start);
+                if (comma == std::string::npos) comma = list.size();
+                if (comma > start) names.push_back(list.substr(start, comma - start));
+            }
+        } else {
+            printf("Usage: %s [--games N (per pairing)] [--threads N (0 = all cores)] [--turns N] [--seed S]\n"
+                   "          [--strategies NAME,NAME,...]\n", argv[0]);
+            return 1;
+        }
+    }
+    for (const std::string &name : names) {
+        if (!MakeMarbleStrategy(name.c_str())) {
+            printf("Unknown strategy '%s'. Known:", name.c_str());
+            for (const char *known : MARBLE_STRATEGIES) printf(" %s", known);
+            printf("\n");
+            return 1;
+        }
+    }
+    const int n = (int)names.size();
+    if (n == 0 || games <= 0 || maxTurns <= 0) {
+        printf("Need at least one strategy, and positive game and turn counts.\n");
+        return 1;
+    }
+
+    // Chunks of every ordered pairing go into one pool; each chunk has its own random stream,
+    // so the totals don't depend on the thread count
+    const long long chunksPerPair = (games + ARENA_CHUNK_GAMES - 1) / ARENA_CHUNK_GAMES;
+    const long long chunkCount = chunksPerPair * n * n;
+    std::vector<PairingResult> chunkResults(chunkCount);
+    TickScheduler scheduler(threads);
+    auto start = std::chrono::steady_clock::now();
+    scheduler.ParallelFor((int)chunkCount, [&](int chunk) {
+        int pair = (int)(chunk / chunksPerPair);
+        long long first = (chunk % chunksPerPair) * ARENA_CHUNK_GAMES;
+        std::unique_ptr<MarbleStrategy> challenger = MakeMarbleStrategy(names[pair / n].c_str());
+        std::unique_ptr<MarbleStrategy> house = MakeMarbleStrategy(names[pair % n].c_str());
+        Pcg32 rng(seed, ((uint64_t)STREAM_MARBLE << 40) + (uint64_t)chunk);
+        PairingResult &r = chunkResults[chunk];
+        for (long long g = first; g < std::min(games, first + ARENA_CHUNK_GAMES); g++) {
+            MarbleWinner w = PlayMarbleGame(*challenger, *house, rng, maxTurns);
+            if (w == MARBLE_CHALLENGER_WON) r.challengerWins++;
+            else if (w == MARBLE_HOUSE_WON) r.houseWins++;
+            else r.draws++;
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<PairingResult> pairs(n * n);
+    for (long long c = 0; c < chunkCount; c++) {
+        PairingResult &p = pairs[c / chunksPerPair];
+        p.challengerWins += chunkResults[c].challengerWins;
+        p.houseWins += chunkResults[c].houseWins;
+        p.draws += chunkResults[c].draws;
+    }
+
+    printf("%lld games per pairing, %d thread(s)\n\nChallenger win %% (rows: challenger, columns: house)\n%-12s",
+           games, scheduler.ThreadCount(), "");
+    for (int h = 0; h < n; h++) printf(" %11s", names[h].c_str());
+    printf("\n");
+    for (int c = 0; c < n; c++) {
+        printf("%-12s", names[c].c_str());
+        for (int h = 0; h < n; h++) printf(" %10.2f%%", 100.0 * pairs[c * n + h].challengerWins / games);
+        printf("\n");
+    }
+
+    // Rank by win rate against the other strategies, both seats weighted equally
+    struct Rank {
+        int id;
+        double asChallenger, asHouse;
+    };
+    std::vector<Rank> ranks;
+    for (int s = 0; s < n; s++) {
+        Rank r = {s, 0.0, 0.0};
+        int opponents = 0;
+        for (int o = 0; o < n; o++) {
+            if (o == s && n > 1) continue;
+            r.asChallenger += (double)pairs[s * n + o].challengerWins / games;
+            r.asHouse += (double)pairs[o * n + s].houseWins / games;
+            opponents++;
+        }
+        r.asChallenger /= opponents;
+        r.asHouse /= opponents;
+        ranks.push_back(r);
+    }
+    std::sort(ranks.begin(), ranks.end(), [](const Rank &a, const Rank &b) {
+        return a.asChallenger + a.asHouse > b.asChallenger + b.asHouse;
+    });
+    printf("\nRank  Strategy      Overall  As challenger  As house\n");
+    for (size_t i = 0; i < ranks.size(); i++)
+        printf("%4zu  %-12s %7.2f%%  %12.2f%%  %7.2f%%\n", i + 1, names[ranks[i].id].c_str(),
+               50.0 * (ranks[i].asChallenger + ranks[i].asHouse), 100.0 * ranks[i].asChallenger,
+               100.0 * ranks[i].asHouse);
+
+    long long draws = 0;
+    for (const PairingResult &p : pairs) draws += p.draws;
+    if (draws) printf("\n%lld games hit the %d-turn limit and count as draws\n", draws, maxTurns);
+    printf("%.3f s, %.2f M games/s\n", seconds, (double)games * n * n / seconds / 1e6);
+    return 0;
+}
@@ -0,0 +1,339 @@
+// Marbles scene
+// Odd-or-even betting against an AI opponent. Hosted by marble.cpp on its own or by the
+// squid_game hub. The AI's decisions come from a MarbleStrategy (marble_ai.h).
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include "marble_ai.h"
+#include "scene.h"
+#include "sim_random.h"
+
+static inline bool isOdd(int num) { return num % 2 != 0; }
+
+struct Button {
+    Rectangle rect;
+    std::string text;
+    bool hovered = false;
+    long long lastClickTick = -1000;
+    static const int clickDelayTicks = 9; // 0.15 s at SIM_TICK_RATE
+
+    Button(float x, float y, float w, float h, const std::string& t)
+        : rect{x, y, w, h}, text(t) {}
+
+    void UpdateHover(const InputFrame &in) {
+        hovered = CheckCollisionPointRec(in.Mouse(), rect);
+    }
+
+    bool IsClicked(const InputFrame &in, long long tick) {
+        if (hovered && in.MousePressed() && (tick - lastClickTick) > clickDelayTicks) {
+            lastClickTick = tick;
+            return true;
+        }
+        return false;
+    }
+
+    void Draw() const {
+        Color col = hovered ? DARKGRAY : LIGHTGRAY;
+        DrawRectangleRec(rect, col);
+        int textWidth = MeasureText(text.c_str(), 22);
+        DrawText(text.c_str(),
+                 (int)(rect.x + rect.width / 2 - textWidth / 2),
+                 (int)(rect.y + rect.height / 2 - 12), 22, BLACK);
+    }
+};
+
+struct PlayerAI {
+    int marbles;
+    bool specialUsed;
+    std::unique_ptr<MarbleStrategy> strategy;
+    Pcg32 rng;
+
+    PlayerAI(int start, uint64_t seed)
+        : marbles(start), specialUsed(false), strategy(MakeMarbleStrategy(MARBLE_DEFAULT_STRATEGY)),
+          rng(seed, STREAM_MARBLE) {}
+
+    bool guessOdd(int playerMarbles) { return strategy->GuessOdd({SEAT_HOUSE, marbles, playerMarbles}, rng); }
+
+    int putMarbles(int playerMarbles) {
+        return strategy->Hide({SEAT_HOUSE, marbles, playerMarbles}, std::min(MARBLE_MAX_PUT, marbles), rng);
+    }
+};
+
+static inline void DrawBar(float x, float y, float width, float height, int value, int maxVal, Color fill) {
+    DrawRectangle((int)x, (int)y, (int)width, (int)height, GRAY);
+    float fillWidth = (value / (float)maxVal) * width;
+    DrawRectangle((int)x, (int)y, (int)fillWidth, (int)height, fill);
+    DrawRectangleLines((int)x, (int)y, (int)width, (int)height, BLACK);
+}
+
+static inline void CreateBetButtons(std::vector<Button> &betButtons, int maxBet, int maxAllowed, int yPos, float w = 80, float h = 50) {
+    betButtons.clear();
+    for (int i = 1; i <= maxBet && i <= maxAllowed; i++) {
+        betButtons.emplace_back(100 + (i - 1) * (w + 10), yPos, w, h, std::to_string(i));
+    }
+}
+
+class MarbleScene : public Scene {
+public:
+    // Input bindings (bit index in InputFrame)
+    enum MarbleInput { IN_RESTART };
+
+    static const int startMarbles = 10;
+    static const int maxBet = 5;
+
+    // Before Init(); unknown names keep the current strategy
+    void UseStrategy(const char *name) {
+        std::unique_ptr<MarbleStrategy> strategy = MakeMarbleStrategy(name);
+        if (!strategy) {
+            printf("Unknown marble AI '%s', using %s\n", name, ai.strategy->Name());
+            return;
+        }
+        ai.strategy = std::move(strategy);
+    }
+
+    ReplayGame ReplayId() const override { return REPLAY_MARBLE; }
+    std::vector<int> Bindings() const override { return {KEY_R}; }
+
+    bool Init(const SceneContext &ctx) override {
+        ai.rng.Seed(ctx.seed, STREAM_MARBLE);
+        results = ctx.results;
+        playerName = ctx.playerName;
+        return true;
+    }
+
+    void Enter() override {
+        // Reset game
+        playerMarbles = startMarbles;
+        ai.marbles = startMarbles;
+        playerTurn = true;
+        roundOver = false;
+        playerGuess = NONE;
+        betPlaced = false;
+        guessMade = false;
+        narration = "Your turn! Guess if AI's marbles are Odd or Even.";
+        playerUsedSpecial = false;
+        specialMoveActive = false;
+        ai.strategy->NewGame();
+        currentBet = 0;
+        aiTurnWait = false;
+        aiTurnResultShow = false;
+        aiWaitTicks = 0;
+        resultShowTicks = 0;
+        betButtons.clear();
+    }
+
+    void Update(const InputFrame &in) override {
+        simTick++;
+
+        // --- INPUT HANDLING ---
+        oddBtn.UpdateHover(in);
+        evenBtn.UpdateHover(in);
+        specialBtn.UpdateHover(in);
+        for (auto& b : betButtons) b.UpdateHover(in);
+
+        if (!roundOver) {
+            if (playerTurn) {
+                if (playerGuess == NONE) {
+                    if (oddBtn.IsClicked(in, simTick)) {
+                        playerGuess = ODD;
+                        narration = "You guessed ODD. Now place your bet.";
+                        maxPossibleBet = playerUsedSpecial ? maxBet * 2 : maxBet;
+                        CreateBetButtons(betButtons, maxPossibleBet, playerMarbles, 530);
+                    } else if (evenBtn.IsClicked(in, simTick)) {
+                        playerGuess = EVEN;
+                        narration = "You guessed EVEN. Now place your bet.";
+                        maxPossibleBet = playerUsedSpecial ? maxBet * 2 : maxBet;
+                        CreateBetButtons(betButtons, maxPossibleBet, playerMarbles, 530);
+                    } else if (specialBtn.IsClicked(in, simTick) && !playerUsedSpecial) {
+                        playerUsedSpecial = true;
+                        specialMoveActive = true;
+                        narration = "Special move activated! Bet will be doubled this turn.";
+                    }
+                } else if (!betPlaced) {
+                    for (auto& b : betButtons) {
+                        if (b.IsClicked(in, simTick)) {
+                            currentBet = std::stoi(b.text);
+                            if (specialMoveActive) currentBet *= 2;
+                            betPlaced = true;
+                            narration = "Bet placed: " + std::to_string(currentBet) + ". Waiting for AI's move...";
+                            aiTurnWait = true;
+                            specialMoveActive = false;
+                            betButtons.clear();
+                            break;
+                        }
+                    }
+                }
+            } else {
+                if (!guessMade) {
+                    if (betButtons.empty()) {
+                        maxPossibleBet = std::min(maxBet, playerMarbles);
+                        CreateBetButtons(betButtons, maxPossibleBet, playerMarbles, 460);
+                    }
+                    for (auto& b : betButtons) {
+                        if (b.IsClicked(in, simTick)) {
+                            playerPutMarbles = std::stoi(b.text);
+                            guessMade = true;
+                            narration = "You placed " + std::to_string(playerPutMarbles) + " marbles. AI is guessing...";
+                            betButtons.clear();
+                            break;
+                        }
+                    }
+                }
+            }
+        } else if (in.Pressed(IN_RESTART)) {
+            Enter();
+        }
+
+        // --- GAME LOGIC ---
+        if (aiTurnWait) {
+            aiWaitTicks++;
+            if (aiWaitTicks > aiDelayTicks) {
+                aiWaitTicks = 0;
+                int aiPut = ai.putMarbles(playerMarbles);
+                narration = "AI put " + std::to_string(aiPut) + " marbles.";
+
+                bool playerGuessOdd = (playerGuess == ODD);
+                ai.strategy->ObserveGuess(playerGuessOdd);
+                if (playerGuessOdd == isOdd(aiPut)) {
+                    narration += " You guessed right! You win marbles.";
+                    playerMarbles += currentBet;
+                    ai.marbles -= currentBet;
+                } else {
+                    narration += " Wrong guess! You lose marbles.";
+                    playerMarbles -= currentBet;
+                    ai.marbles += currentBet;
+                }
+
+                betPlaced = false;
+                playerGuess = NONE;
+                aiTurnWait = false;
+                playerTurn = false;
+
+                if (playerMarbles <= 0 || ai.marbles <= 0) EndRound();
+            }
+        }
+
+        if (!playerTurn && guessMade && !aiTurnResultShow) {
+            int aiGuessOdd = ai.guessOdd(playerMarbles);
+            narration = "AI guesses your marbles are " + std::string(aiGuessOdd ? "Odd." : "Even.");
+
+            if (aiGuessOdd == isOdd(playerPutMarbles)) {
+                narration += " AI guessed right! It wins marbles.";
+                playerMarbles -= playerPutMarbles;
+                ai.marbles += playerPutMarbles;
+            } else {
+                narration += " AI guessed wrong! You win marbles.";
+                playerMarbles += playerPutMarbles;
+                ai.marbles -= playerPutMarbles;
+            }
+
+            ai.strategy->ObserveHide(playerPutMarbles);
+            guessMade = false;
+            aiTurnResultShow = true;
+
+            if (playerMarbles <= 0 || ai.marbles <= 0) EndRound();
+        }
+
+        if (aiTurnResultShow) {
+            resultShowTicks++;
+            if (resultShowTicks > resultDelayTicks) {
+                resultShowTicks = 0;
+                aiTurnResultShow = false;
+                playerTurn = true;
+                narration = "Your turn! Guess if AI's marbles are Odd or Even.";
+            }
+        }
+    }
+
+    void Draw(float, const InputFrame &preview) override {
+        // Hover highlight follows the live (or replayed) mouse between ticks
+        oddBtn.UpdateHover(preview);
+        evenBtn.UpdateHover(preview);
+        specialBtn.UpdateHover(preview);
+        for (auto& b : betButtons) b.UpdateHover(preview);
+
+        ClearBackground(RAYWHITE);
+
+        DrawText("Your Marbles", 100, 50, 24, BLACK);
+        DrawBar(100, 85, 250, 35, playerMarbles, startMarbles, BLUE);
+
+        DrawText("AI Marbles", 500, 50, 24, BLACK);
+        DrawBar(500, 85, 250, 35, ai.marbles, startMarbles, RED);
+
+        DrawText(narration.c_str(), 50, 150, 22, DARKGRAY);
+
+        if (!roundOver) {
+            if (playerTurn) {
+                if (playerGuess == NONE) {
+                    DrawText("Select your guess:", 100, 400, 22, BLACK);
+                    oddBtn.Draw();
+                    evenBtn.Draw();
+                    if (!playerUsedSpecial) specialBtn.Draw();
+                } else if (!betPlaced) {
+                    DrawText("Select your bet:", 100, 500, 22, BLACK);
+                    for (auto& b : betButtons) b.Draw();
+                }
+            } else if (!guessMade) {
+                DrawText("Choose how many marbles to put forward:", 100, 400, 22, BLACK);
+                for (auto& b : betButtons) b.Draw();
+            }
+        } else {
+            DrawText("Round Over!", 350, 300, 40, DARKGREEN);
+            DrawText(narration.c_str(), 200, 350, 25, BLACK);
+            DrawText("Press R to restart.", 300, 400, 20, DARKGRAY);
+        }
+    }
+
+    // Everything waits on a click except the AI's two timed pauses
+    int IdleTicks() const override {
+        if (aiTurnWait) return aiDelayTicks + 1 - aiWaitTicks;
+        if (aiTurnResultShow) return resultDelayTicks + 1 - resultShowTicks;
+        // The next tick lays out the marble buttons or resolves the AI's guess
+        if (!roundOver && !playerTurn && (guessMade || betButtons.empty())) return 0;
+        return SCENE_IDLE_UNTIL_INPUT;
+    }
+
+    void Shutdown() override {}
+
+private:
+    enum GuessChoice { NONE, ODD, EVEN };
+
+    void EndRound() {
+        roundOver = true;
+        if (results) results->Record(REPLAY_MARBLE, playerName.c_str(), ai.marbles <= 0 ? RESULT_WON : RESULT_LOST);
+    }
+
+    TournamentResults *results = nullptr;
+    std::string playerName;
+
+    PlayerAI ai{startMarbles, 0};
+    int playerMarbles = startMarbles;
+    bool playerTurn = true;
+    bool roundOver = false;
+    bool specialMoveActive = false;
+    bool playerUsedSpecial = false;
+
+    int currentBet = 0;
+    bool betPlaced = false;
+    bool guessMade = false;
+    bool aiTurnWait = false;
+    bool aiTurnResultShow = false;
+    GuessChoice playerGuess = NONE;
+    int playerPutMarbles = 0;
+    std::string narration;
+
+    Button oddBtn{100, 450, 160, 55, "Guess Odd"};
+    Button evenBtn{300, 450, 160, 55, "Guess Even"};
+    Button specialBtn{550, 450, 220, 55, "Use Double Bet (Once)"};
+    std::vector<Button> betButtons;
+    int maxPossibleBet = maxBet;
+
+    const int aiDelayTicks = FixedStepClock().TicksFor(1.5);     // pause before the AI reveals its marbles
+    const int resultDelayTicks = FixedStepClock().TicksFor(2.0); // how long the AI's guess stays on screen
+    int aiWaitTicks = 0;
+    int resultShowTicks = 0;
+    long long simTick = 0;
+};
@@ -0,0 +1,140 @@
+// On-disk cache of outline fields
+// BuildOutlineField scans every pixel and runs a distance transform; the result only depends
+// on the image file and the outline rule, so it is stored next to the asset as
+// "<image>.outline" and reused for as long as the file's content hash and the rule's key match.
+// The image is decoded from the file itself, never read back from a GPU texture.
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "dalgona_outline.h"
+
+const uint32_t OUTLINE_CACHE_VERSION = 1;
+
+struct OutlineCacheHeader {
+    char magic[4]; // "SQOL"
+    uint32_t version;
+    uint64_t contentHash; // FNV-1a of the image file
+    uint32_t ruleKey;     // caller's identifier for the outline rule (e.g. its threshold)
+    int32_t width;
+    int32_t height;
+    int32_t outlinePixels;
+}; // followed by visible tiles, outline tiles, then width*height distance bytes
+
+static_assert(sizeof(OutlineCacheHeader) == 32, "outline cache header layout");
+
+static inline uint64_t HashBytes64(const unsigned char *data, size_t size) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++) h = (h ^ data[i]) * 1099511628211ULL;
+    return h;
+}
+
+// Bytes a cache file for a width x height image holds after its header
+static inline uint64_t OutlineCachePayloadSize(int width, int height) {
+    uint64_t tiles = (uint64_t)((width + TILE_SIZE - 1) / TILE_SIZE) *
+                     ((height + TILE_SIZE - 1) / TILE_SIZE);
+    return 2 * tiles * sizeof(uint64_t) + (uint64_t)width * height;
+}
+
+// Width and height from a PNG's IHDR chunk, without decoding it
+static inline bool PngSize(const unsigned char *data, int size, int &width, int &height) {
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    if (size < 24 || memcmp(data, signature, 8) != 0 || memcmp(data + 12, "IHDR", 4) != 0) return false;
+    auto be32 = [&](int at) {
+        return (uint32_t)data[at] << 24 | (uint32_t)data[at + 1] << 16 | (uint32_t)data[at + 2] << 8 | data[at + 3];
+    };
+    uint32_t w = be32(16), h = be32(20);
+    if (w == 0 || h == 0 || w > INT32_MAX || h > INT32_MAX) return false;
+    width = (int)w;
+    height = (int)h;
+    return true;
+}
+
+// Only a file for exactly this image (content, size) and rule, with exactly the payload that
+// size needs, is used; anything else is a miss
+static inline bool ReadOutlineCache(const std::string &cachePath, uint64_t contentHash, uint32_t ruleKey,
+                                    int width, int height, OutlineField &field) {
+    FILE *f = fopen(cachePath.c_str(), "rb");
+    if (!f) return false;
+    OutlineCacheHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, "SQOL", 4) == 0 &&
+              h.version == OUTLINE_CACHE_VERSION && h.contentHash == contentHash && h.ruleKey == ruleKey &&
+              h.width == width && h.height == height && width > 0 && height > 0 &&
+              h.outlinePixels >= 0 && (int64_t)h.outlinePixels <= (int64_t)width * height;
+    if (ok) {
+        long payloadStart = ftell(f);
+        ok = fseek(f, 0, SEEK_END) == 0 &&
+             (uint64_t)(ftell(f) - payloadStart) == OutlineCachePayloadSize(width, height) &&
+             fseek(f, payloadStart, SEEK_SET) == 0;
+    }
+    if (ok) {
+        field.width = h.width;
+        field.height = h.height;
+        field.outlinePixels = h.outlinePixels;
+        field.visible.Resize(h.width, h.height);
+        field.outline.Resize(h.width, h.height);
+        field.distance.resize((size_t)h.width * h.height);
+        size_t tiles = field.visible.tiles.size();
+        ok = fread(field.visible.tiles.data(), sizeof(uint64_t), tiles, f) == tiles &&
+             fread(field.outline.tiles.data(), sizeof(uint64_t), tiles, f) == tiles &&
+             fread(field.distance.data(), 1, field.distance.size(), f) == field.distance.size();
+        field.visible.Recount();
+        field.outline.Recount();
+    }
+    fclose(f);
+    if (!ok) field = OutlineField();
+    return ok;
+}
+
+// Best effort: a read-only install just rebuilds every run
+static inline void WriteOutlineCache(const std::string &cachePath, uint64_t contentHash, uint32_t ruleKey,
+                                     const OutlineField &field) {
+    FILE *f = fopen(cachePath.c_str(), "wb");
+    if (!f) return;
+    OutlineCacheHeader h = {{'S', 'Q', 'O', 'L'}, OUTLINE_CACHE_VERSION, contentHash, ruleKey,
+                            field.width, field.height, field.outlinePixels};
+    fwrite(&h, sizeof(h), 1, f);
+    fwrite(field.visible.tiles.data(), sizeof(uint64_t), field.visible.tiles.size(), f);
+    fwrite(field.outline.tiles.data(), sizeof(uint64_t), field.outline.tiles.size(), f);
+    fwrite(field.distance.data(), 1, field.distance.size(), f);
+    fclose(f);
+}
+
+// Outline field for an image file: from "<path>.outline" when it is current, otherwise built
+// from the decoded file and cached. ruleKey must change whenever isOutline's behaviour does.
+// Returns an empty field (width 0) if the image can't be read. The cache is checked against
+// the image's real size: read from a PNG's header, otherwise from the decoded image.
+template <typename IsOutlinePixel>
+OutlineField LoadOrBuildOutlineField(const char *imagePath, uint32_t ruleKey, IsOutlinePixel isOutline) {
+    OutlineField field;
+    int size = 0;
+    unsigned char *data = LoadFileData(imagePath, &size);
+    if (!data) return field;
+    uint64_t contentHash = HashBytes64(data, (size_t)size);
+    std::string cachePath = std::string(imagePath) + ".outline";
+
+    Image img = {};
+    int width = 0, height = 0;
+    if (!PngSize(data, size, width, height)) {
+        img = LoadImageFromMemory(GetFileExtension(imagePath), data, size);
+        width = img.width;
+        height = img.height;
+    }
+    if (width <= 0 || !ReadOutlineCache(cachePath, contentHash, ruleKey, width, height, field)) {
+        if (!img.data) img = LoadImageFromMemory(GetFileExtension(imagePath), data, size);
+        if (img.data) {
+            ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            field = BuildOutlineField((const Color *)img.data, img.width, img.height, isOutline);
+            WriteOutlineCache(cachePath, contentHash, ruleKey, field);
+        }
+    }
+    if (img.data) UnloadImage(img);
+    UnloadFileData(data);
+    return field;
+}
+
+static inline OutlineField LoadOrBuildOutlineField(const char *imagePath, const OutlineRule &rule) {
+    return LoadOrBuildOutlineField(imagePath, rule.Key(), rule);
+}
@@ -0,0 +1,207 @@
+// Outlined text from a glyph atlas
+// Drawing a string 25 times at 5x5 offsets fakes an outline at 25x the cost. Instead, each
+// glyph is rasterized once per font size into an atlas texture, together with a copy dilated
+// by the outline radius. A label is then one outline quad and one fill quad per glyph, all
+// from the same texture, so raylib batches the whole label into a single draw. Label layouts
+// (glyph quads relative to the origin) are cached too, so static strings skip UTF-8 decoding
+// and glyph lookups entirely. Output matches DrawText() with the same font size.
+#pragma once
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "image_kernels.h"
+
+const int OUTLINED_TEXT_ATLAS_SIZE = 1024;
+const int OUTLINED_TEXT_LAYOUT_MAX = 256; // cached label layouts before old ones are dropped
+const float OUTLINED_TEXT_LINE_SPACING = 2.0f; // raylib's default text line spacing
+
+class OutlinedText {
+public:
+    // After InitWindow(). radius is the outline width in pixels (the old 5x5 loop was 2).
+    void Load(Font textFont, int radius = 2) {
+        font = textFont;
+        outline = radius;
+        Image blank = GenImageColor(OUTLINED_TEXT_ATLAS_SIZE, OUTLINED_TEXT_ATLAS_SIZE, BLANK);
+        atlas = LoadTextureFromImage(blank);
+        UnloadImage(blank);
+        SetTextureFilter(atlas, TEXTURE_FILTER_POINT);
+        Reset();
+    }
+
+    void Unload() {
+        if (atlas.id != 0) UnloadTexture(atlas);
+        atlas = {};
+        glyphs.clear();
+        layouts.clear();
+    }
+
+    // Same placement and size as DrawText(text, x, y, fontSize, ...)
+    void Draw(const char *text, int x, int y, int fontSize, Color textColor, Color outlineColor) {
+        if (atlas.id == 0) return;
+        fontSize = std::max(fontSize, 10);
+        const Layout *found = GetLayout(text, fontSize);
+        if (!found) { // too big for the atlas even on its own: the old offset-copy outline
+            for (int dy = -outline; dy <= outline; dy++)
+                for (int dx = -outline; dx <= outline; dx++) DrawText(text, x + dx, y + dy, fontSize, outlineColor);
+            DrawText(text, x, y, fontSize, textColor);
+            return;
+        }
+        const Layout &layout = *found;
+        for (const Quad &q : layout.quads)
+            DrawTexturePro(atlas, q.outlineSrc, {x + q.x - outline, y + q.y - outline, q.outlineSrc.width,
+                                                 q.outlineSrc.height}, {0, 0}, 0.0f, outlineColor);
+        for (const Quad &q : layout.quads)
+            DrawTexturePro(atlas, q.fillSrc, {x + q.x, y + q.y, q.fillSrc.width, q.fillSrc.height}, {0, 0}, 0.0f,
+                           textColor);
+    }
+
+private:
+    struct Glyph {
+        Rectangle fillSrc;
+        Rectangle outlineSrc;
+    };
+    struct Quad {
+        float x, y; // offset of the fill rectangle from the label origin
+        Rectangle fillSrc;
+        Rectangle outlineSrc;
+    };
+    struct Layout {
+        std::vector<Quad> quads;
+        uint64_t lastUse = 0;
+    };
+
+    void Reset() {
+        glyphs.clear();
+        layouts.clear();
+        shelfX = shelfY = shelfH = 0;
+    }
+
+    // Laid out exactly like DrawTextEx() with DrawText()'s spacing (fontSize / 10). Null if the
+    // label's glyphs don't fit even in an emptied atlas.
+    const Layout *GetLayout(const char *text, int fontSize, bool afterReset = false) {
+        std::string key = std::to_string(fontSize) + '\x1f' + text;
+        auto it = layouts.find(key);
+        if (it == layouts.end()) {
+            if (layouts.size() >= OUTLINED_TEXT_LAYOUT_MAX) DropOldLayouts();
+            Layout layout;
+            float scale = (float)fontSize / font.baseSize;
+            float spacing = (float)(fontSize / 10);
+            float offsetX = 0.0f, offsetY = 0.0f;
+            for (const char *p = text; *p;) {
+                int bytes = 0;
+                int codepoint = GetCodepointNext(p, &bytes);
+                p += bytes;
+                int index = GetGlyphIndex(font, codepoint);
+                if (codepoint == '\n') {
+                    offsetY += fontSize + OUTLINED_TEXT_LINE_SPACING;
+                    offsetX = 0.0f;
+                    continue;
+                }
+                if (codepoint != ' ' && codepoint != '\t') {
+                    int w, h;
+                    GlyphSize(index, fontSize, w, h);
+                    // Never fits, even alone: don't throw away everything else for it
+                    if (w + 2 * outline + 1 > OUTLINED_TEXT_ATLAS_SIZE || h + 2 * outline + 1 > OUTLINED_TEXT_ATLAS_SIZE)
+                        return nullptr;
+                    const Glyph *g = GetGlyph(index, fontSize);
+                    if (!g) { // atlas full: start over once with only what is drawn from now on
+                        if (afterReset) return nullptr;
+                        Reset();
+                        return GetLayout(text, fontSize, true);
+                    }
+                    layout.quads.push_back({roundf(offsetX + font.glyphs[index].offsetX * scale),
+                                            roundf(offsetY + font.glyphs[index].offsetY * scale), g->fillSrc,
+                                            g->outlineSrc});
+                }
+                float advance = font.glyphs[index].advanceX ? font.glyphs[index].advanceX : font.recs[index].width;
+                offsetX += advance * scale + spacing;
+            }
+            it = layouts.emplace(std::move(key), std::move(layout)).first;
+        }
+        it->second.lastUse = ++useClock;
+        return &it->second;
+    }
+
+    // Drop the older half of the cached layouts (dynamic strings like timers pile up otherwise)
+    void DropOldLayouts() {
+        uint64_t cutoff = useClock - OUTLINED_TEXT_LAYOUT_MAX / 2;
+        for (auto it = layouts.begin(); it != layouts.end();) {
+            if (it->second.lastUse <= cutoff) it = layouts.erase(it);
+            else ++it;
+        }
+    }
+
+    // Size of a glyph's fill rectangle at fontSize
+    void GlyphSize(int index, int fontSize, int &w, int &h) const {
+        float scale = (float)fontSize / font.baseSize;
+        w = std::max(1, (int)roundf(font.recs[index].width * scale));
+        h = std::max(1, (int)roundf(font.recs[index].height * scale));
+    }
+
+    // Rasterize a glyph at fontSize (nearest-neighbour, like DrawText's point-sampled scaling)
+    // plus its outline, and upload both into free atlas space. Null if the atlas is full.
+    const Glyph *GetGlyph(int index, int fontSize) {
+        uint64_t key = (uint64_t)fontSize << 32 | (uint32_t)index;
+        auto it = glyphs.find(key);
+        if (it != glyphs.end()) return &it->second;
+
+        Image src = ImageCopy(font.glyphs[index].image);
+        ImageFormat(&src, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        float scale = (float)fontSize / font.baseSize;
+        int w, h;
+        GlyphSize(index, fontSize, w, h);
+        int ow = w + 2 * outline, oh = h + 2 * outline;
+
+        std::vector<unsigned char> coverage((size_t)w * h, 0);
+        std::vector<Color> fill((size_t)w * h, BLANK);
+        const Color *srcPixels = (const Color *)src.data;
+        for (int y = 0; y < h && src.data; y++) {
+            int sy = std::min(src.height - 1, (int)(y / scale));
+            for (int x = 0; x < w; x++) {
+                int sx = std::min(src.width - 1, (int)(x / scale));
+                unsigned char a = srcPixels[sy * src.width + sx].a;
+                coverage[y * w + x] = a;
+                fill[y * w + x] = {255, 255, 255, a};
+            }
+        }
+        UnloadImage(src);
+
+        // Outline = fill dilated by the radius (the union of every offset copy the old loop drew)
+        std::vector<unsigned char> dilated((size_t)ow * oh);
+        DilateMax8(coverage.data(), w, h, outline, dilated.data());
+        std::vector<Color> border((size_t)ow * oh);
+        for (size_t i = 0; i < border.size(); i++) border[i] = {255, 255, 255, dilated[i]};
+
+        Rectangle fillRec, outlineRec;
+        if (!Allocate(w, h, fillRec) || !Allocate(ow, oh, outlineRec)) return nullptr;
+        UpdateTextureRec(atlas, fillRec, fill.data());
+        UpdateTextureRec(atlas, outlineRec, border.data());
+        return &glyphs.emplace(key, Glyph{fillRec, outlineRec}).first->second;
+    }
+
+    // Shelf packing with a 1-pixel gutter so point sampling never bleeds between glyphs
+    bool Allocate(int w, int h, Rectangle &out) {
+        if (shelfX + w + 1 > OUTLINED_TEXT_ATLAS_SIZE) {
+            shelfY += shelfH + 1;
+            shelfX = 0;
+            shelfH = 0;
+        }
+        if (shelfY + h + 1 > OUTLINED_TEXT_ATLAS_SIZE || w + 1 > OUTLINED_TEXT_ATLAS_SIZE) return false;
+        out = {(float)shelfX, (float)shelfY, (float)w, (float)h};
+        shelfX += w + 1;
+        shelfH = std::max(shelfH, h);
+        return true;
+    }
+
+    Font font = {};
+    int outline = 2;
+    Texture2D atlas = {};
+    std::unordered_map<uint64_t, Glyph> glyphs; // key: fontSize << 32 | glyph index
+    std::unordered_map<std::string, Layout> layouts;
+    uint64_t useClock = 0;
+    int shelfX = 0, shelfY = 0, shelfH = 0;
+};
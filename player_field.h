@@ -0,0 +1,138 @@
+// Structure-of-arrays player store for Red Light, Green Light
+// Positions, glow phases and finish times live in separate contiguous float arrays and the
+// alive/finished flags are bitmasks, 64 players per word. The per-tick update runs one word
+// (64 players) at a time with SSE2/AVX2 when available and a branch-free scalar fallback.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "tiled_bitset.h" // PopCount64, CountTrailingZeros64
+
+const int PLAYERS_PER_WORD = 64;
+
+// Per-word result of one update: which players left the field this tick
+struct FieldWordEvents {
+    uint64_t eliminated;
+    uint64_t finished;
+};
+
+struct PlayerField {
+    size_t count = 0;
+    size_t words = 0;                // ceil(count / 64); arrays are padded to words * 64
+    std::vector<float> x;
+    std::vector<float> glowPhase;
+    std::vector<float> finishTime;   // -1 until the player crosses the line
+    std::vector<uint64_t> alive;     // bit i%64 of word i/64
+    std::vector<uint64_t> finished;
+    std::vector<FieldWordEvents> wordEvents; // per-word results of the last tick
+
+    void Resize(size_t n) {
+        count = n;
+        words = (n + PLAYERS_PER_WORD - 1) / PLAYERS_PER_WORD;
+        x.assign(words * PLAYERS_PER_WORD, 0.0f);
+        glowPhase.assign(words * PLAYERS_PER_WORD, 0.0f);
+        finishTime.assign(words * PLAYERS_PER_WORD, -1.0f);
+        alive.assign(words, 0);
+        finished.assign(words, 0);
+    }
+
+    // Everyone back on the start line; padding lanes stay dead so they never move or finish
+    void Reset(float startX) {
+        std::fill(x.begin(), x.end(), startX);
+        std::fill(glowPhase.begin(), glowPhase.end(), 0.0f);
+        std::fill(finishTime.begin(), finishTime.end(), -1.0f);
+        std::fill(finished.begin(), finished.end(), 0);
+        std::fill(alive.begin(), alive.end(), ~0ULL);
+        if (count % PLAYERS_PER_WORD) alive[words - 1] = (1ULL << (count % PLAYERS_PER_WORD)) - 1;
+    }
+
+    bool IsAlive(size_t i) const { return (alive[i / 64] >> (i % 64)) & 1; }
+    bool IsFinished(size_t i) const { return (finished[i / 64] >> (i % 64)) & 1; }
+
+    size_t ActiveCount() const {
+        size_t n = 0;
+        for (size_t w = 0; w < words; w++) n += PopCount64(alive[w] & ~finished[w]);
+        return n;
+    }
+};
+
+// Add step to the lanes whose bit is set in moveBits, advance glow on the lanes set in glowBits
+// and return a bitmask of lanes at or past finishX. Operates on 64 consecutive players.
+static inline uint64_t MoveAndCompareWord(float *x, float *glow, uint64_t moveBits, uint64_t glowBits,
+                                          float step, float glowSpeed, float finishX) {
+    uint64_t atFinish = 0;
+#if defined(__AVX2__)
+    const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256 stepV = _mm256_set1_ps(step);
+    const __m256 glowV = _mm256_set1_ps(glowSpeed);
+    const __m256 finishV = _mm256_set1_ps(finishX);
+    for (int lane = 0; lane < 64; lane += 8) {
+        __m256i mb = _mm256_set1_epi32((int)((moveBits >> lane) & 0xFF));
+        __m256i gb = _mm256_set1_epi32((int)((glowBits >> lane) & 0xFF));
+        __m256 moveMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(mb, laneBits), laneBits));
+        __m256 glowMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(gb, laneBits), laneBits));
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + lane), _mm256_and_ps(stepV, moveMask));
+        __m256 pg = _mm256_add_ps(_mm256_loadu_ps(glow + lane), _mm256_and_ps(glowV, glowMask));
+        _mm256_storeu_ps(x + lane, px);
+        _mm256_storeu_ps(glow + lane, pg);
+        atFinish |= (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(px, finishV, _CMP_GE_OQ)) << lane;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i laneBits = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128 stepV = _mm_set1_ps(step);
+    const __m128 glowV = _mm_set1_ps(glowSpeed);
+    const __m128 finishV = _mm_set1_ps(finishX);
+    for (int lane = 0; lane < 64; lane += 4) {
+        __m128i mb = _mm_set1_epi32((int)((moveBits >> lane) & 0xF));
+        __m128i gb = _mm_set1_epi32((int)((glowBits >> lane) & 0xF));
+        __m128 moveMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(mb, laneBits), laneBits));
+        __m128 glowMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(gb, laneBits), laneBits));
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + lane), _mm_and_ps(stepV, moveMask));
+        __m128 pg = _mm_add_ps(_mm_loadu_ps(glow + lane), _mm_and_ps(glowV, glowMask));
+        _mm_storeu_ps(x + lane, px);
+        _mm_storeu_ps(glow + lane, pg);
+        atFinish |= (uint64_t)_mm_movemask_ps(_mm_cmpge_ps(px, finishV)) << lane;
+    }
+#else
+    for (int lane = 0; lane < 64; lane++) {
+        x[lane] += step * (float)((moveBits >> lane) & 1);
+        glow[lane] += glowSpeed * (float)((glowBits >> lane) & 1);
+        atFinish |= (uint64_t)(x[lane] >= finishX) << lane;
+    }
+#endif
+    return atFinish;
+}
+
+// One tick for words [firstWord, lastWord). Red light eliminates every active player holding
+// move; green light moves them. Eliminations never need the float arrays, and words with no
+// active players are skipped entirely.
+static inline void UpdateFieldWords(PlayerField &field, const uint64_t *wantsMove, bool green,
+                                    float step, float glowSpeed, float finishX, float finishTime,
+                                    size_t firstWord, size_t lastWord, FieldWordEvents *out) {
+    for (size_t w = firstWord; w < lastWord; w++) {
+        uint64_t active = field.alive[w] & ~field.finished[w];
+        uint64_t movers = wantsMove[w] & active;
+        uint64_t eliminated = green ? 0 : movers;
+        FieldWordEvents ev = {eliminated, 0};
+
+        if (active) {
+            field.alive[w] &= ~eliminated;
+            uint64_t stillActive = active & ~eliminated;
+            uint64_t atFinish = MoveAndCompareWord(&field.x[w * 64], &field.glowPhase[w * 64],
+                                                   green ? movers : 0, active, step, glowSpeed, finishX);
+            ev.finished = atFinish & stillActive;
+            field.finished[w] |= ev.finished;
+            for (uint64_t bits = ev.finished; bits; bits &= bits - 1)
+                field.finishTime[w * 64 + CountTrailingZeros64(bits)] = finishTime;
+        }
+        out[w - firstWord] = ev;
+    }
+}
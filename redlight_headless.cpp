@@ -0,0 +1,125 @@
+// Headless Red Light, Green Light runner
+// Steps N players through full rounds at a fixed tick rate with no window or audio,
+// and reports how many ticks per second the rules sustain.
+//
+//   g++ -std=c++17 -O2 -pthread redlight_headless.cpp -o redlight_headless
+//   ./redlight_headless --players 10000 --rounds 5 --threads 0
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include "redlight_sim.h"
+
+int main(int argc, char **argv) {
+    int playerCount = 10000;
+    int rounds = 1;
+    int tickRate = 60;
+    int threads = 1;
+    uint64_t seed = 456;
+    float moveChance = 0.8f;
+    const char *replayPath = nullptr;
+    const char *recordPath = nullptr;
+    RedLightRules rules;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--players") && hasValue) playerCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rounds") && hasValue) rounds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--tickrate") && hasValue) tickRate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && hasValue) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--move-chance") && hasValue) moveChance = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--green") && hasValue) rules.greenDuration = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--replay") && hasValue) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--record") && hasValue) recordPath = argv[++i];
+        else {
+            printf("Usage: %s [--players N] [--rounds N] [--tickrate HZ] [--threads N (0 = all cores)] [--seed S]\n"
+                   "          [--move-chance P] [--green SECONDS] [--replay FILE | --record FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (playerCount <= 0 || tickRate <= 0) {
+        printf("Player count and tick rate must be positive.\n");
+        return 1;
+    }
+
+    // Pick the input source: replay file, or bots (optionally recorded)
+    std::unique_ptr<RedLightInput> bots;
+    std::unique_ptr<RedLightInput> input;
+    if (replayPath) {
+        auto replay = std::make_unique<ReplayFileInput>(replayPath);
+        if (!replay->IsOpen()) {
+            printf("Failed to open replay %s\n", replayPath);
+            return 1;
+        }
+        playerCount = (int)replay->PlayerCount();
+        input = std::move(replay);
+    } else {
+        bots = std::make_unique<BotInput>(playerCount, seed, moveChance);
+        if (recordPath) input = std::make_unique<RecordingInput>(*bots, recordPath, (uint32_t)playerCount);
+    }
+    RedLightInput &source = input ? *input : *bots;
+
+    const float dt = 1.0f / tickRate;
+    PlayerField players;
+    players.Resize(playerCount);
+    std::vector<uint64_t> wantsMove(players.words, 0);
+    std::vector<RedLightEvent> events;
+    RedLightState state;
+    TickScheduler scheduler(threads);
+
+    long long totalTicks = 0;
+    long long finished = 0, eliminated = 0;
+    unsigned long long eventHash = 1469598103934665603ULL;
+    double totalSeconds = 0.0;
+    double stepSeconds = 0.0; // StepRedLight alone, without input sampling
+
+    for (int round = 0; round < rounds; round++) {
+        StartRedLight(state, rules, players, 80.0f);
+
+        auto start = std::chrono::steady_clock::now();
+        while (!IsRedLightOver(state, players)) {
+            source.Sample(state, players, wantsMove);
+            events.clear();
+            auto stepStart = std::chrono::steady_clock::now();
+            StepRedLight(state, rules, players, wantsMove, dt, events, &scheduler);
+            stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+            for (const RedLightEvent &e : events) {
+                eventHash = (eventHash ^ (unsigned long long)(e.type * 0x10000000ULL + e.player + 1)) * 1099511628211ULL;
+                if (e.type == EVENT_FINISHED) finished++;
+                else if (e.type == EVENT_ELIMINATED) eliminated++;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        totalTicks += state.tick;
+        totalSeconds += std::chrono::duration<double>(end - start).count();
+    }
+
+    // Hash of the final field and event order, to check runs (and thread counts) agree
+    unsigned long long checksum = 1469598103934665603ULL;
+    auto mix = [&](const void *data, size_t bytes) {
+        const unsigned char *p = (const unsigned char *)data;
+        for (size_t i = 0; i < bytes; i++) checksum = (checksum ^ p[i]) * 1099511628211ULL;
+    };
+    mix(players.x.data(), players.x.size() * sizeof(float));
+    mix(players.finishTime.data(), players.finishTime.size() * sizeof(float));
+    mix(players.alive.data(), players.alive.size() * sizeof(uint64_t));
+    mix(players.finished.data(), players.finished.size() * sizeof(uint64_t));
+    mix(&eventHash, sizeof(eventHash));
+
+    printf("players:      %d\n", playerCount);
+    printf("threads:      %d\n", scheduler.ThreadCount());
+    printf("rounds:       %d\n", rounds);
+    printf("ticks:        %lld (%.1f simulated seconds at %d Hz)\n", totalTicks, totalTicks * dt, tickRate);
+    printf("finished:     %lld\n", finished);
+    printf("eliminated:   %lld\n", eliminated);
+    printf("checksum:     %016llx\n", checksum);
+    printf("wall time:    %.3f s\n", totalSeconds);
+    printf("ticks/sec:    %.1f\n", totalSeconds > 0 ? totalTicks / totalSeconds : 0.0);
+    printf("player-ticks/sec: %.3g\n", totalSeconds > 0 ? totalTicks * (double)playerCount / totalSeconds : 0.0);
+    printf("step time:    %.3f ms/tick (rules only, excluding input)\n",
+           totalTicks > 0 ? stepSeconds * 1000.0 / totalTicks : 0.0);
+    return 0;
+}
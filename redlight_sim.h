@@ -0,0 +1,213 @@
+// Red Light, Green Light rules
+// Pure game rules over a structure-of-arrays player field: no window, no audio, no raylib.
+// The windowed game and the headless runner both drive StepRedLight() and react to the
+// events it emits.
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include "player_field.h"
+#include "tick_scheduler.h"
+#include "sim_random.h"
+
+enum Phase { PHASE_GREEN, PHASE_RED };
+
+struct RedLightRules {
+    float roundTime = 30.0f;     // seconds until the round ends
+    float greenDuration = 4.0f;  // normally the length of poem.mp3
+    float redDuration = 2.0f;
+    float finishX = 1130.0f;     // SCREEN_WIDTH - 150 in the windowed game
+    float stepDistance = 4.0f;   // distance per tick while the move key is held
+    float glowSpeed = 0.05f;
+};
+
+struct RedLightState {
+    Phase phase = PHASE_GREEN;
+    float phaseTimer = 0.0f;
+    float gameTimer = 0.0f;
+    int tick = 0;
+};
+
+enum RedLightEventType { EVENT_GREEN_LIGHT, EVENT_RED_LIGHT, EVENT_ELIMINATED, EVENT_FINISHED };
+
+struct RedLightEvent {
+    RedLightEventType type;
+    int player; // -1 for phase changes
+};
+
+// Where the per-tick "is this player holding move" bits come from
+class RedLightInput {
+public:
+    virtual ~RedLightInput() = default;
+    // Fill wantsMove (field.words words, bit i%64 of word i/64) for the coming tick
+    virtual void Sample(const RedLightState &state, const PlayerField &field,
+                        std::vector<uint64_t> &wantsMove) = 0;
+};
+
+static inline void StartRedLight(RedLightState &state, const RedLightRules &rules,
+                                 PlayerField &field, float startX) {
+    state = RedLightState();
+    state.gameTimer = rules.roundTime;
+    field.Reset(startX);
+}
+
+static inline bool AreAllPlayersDeadOrFinished(const PlayerField &field) {
+    for (size_t w = 0; w < field.words; w++) if (field.alive[w] & ~field.finished[w]) return false;
+    return true;
+}
+
+static inline bool IsRedLightOver(const RedLightState &state, const PlayerField &field) {
+    return state.gameTimer <= 0 || AreAllPlayersDeadOrFinished(field);
+}
+
+// Turn one word's elimination/finish masks into events, in player order
+static inline void AppendWordEvents(size_t word, const FieldWordEvents &ev, std::vector<RedLightEvent> &events) {
+    for (uint64_t bits = ev.eliminated | ev.finished; bits; bits &= bits - 1) {
+        int lane = CountTrailingZeros64(bits);
+        RedLightEventType type = ((ev.finished >> lane) & 1) ? EVENT_FINISHED : EVENT_ELIMINATED;
+        events.push_back({type, (int)(word * 64 + lane)});
+    }
+}
+
+// Phase timers for one tick; emits the phase change event if the doll turns
+static inline void AdvanceRedLightClock(RedLightState &state, const RedLightRules &rules, float dt,
+                                       std::vector<RedLightEvent> &events) {
+    state.tick++;
+    state.gameTimer -= dt;
+    state.phaseTimer += dt;
+
+    if (state.phase == PHASE_GREEN && state.phaseTimer >= rules.greenDuration) {
+        state.phase = PHASE_RED;
+        state.phaseTimer = 0;
+        events.push_back({EVENT_RED_LIGHT, -1});
+    } else if (state.phase == PHASE_RED && state.phaseTimer >= rules.redDuration) {
+        state.phase = PHASE_GREEN;
+        state.phaseTimer = 0;
+        events.push_back({EVENT_GREEN_LIGHT, -1});
+    }
+}
+
+const size_t WORDS_PER_CHUNK = 128; // 8192 players per scheduler chunk
+
+// Advance the round by dt seconds: phase timers first, then every active player moves
+// (green) or is eliminated for moving (red), then finish detection.
+// With a scheduler the field is split into chunks that update on the thread pool; each word
+// writes its own slot of wordEvents and the events are merged in player order afterwards,
+// so the result is bit-for-bit the same as the single-threaded path.
+static inline void StepRedLight(RedLightState &state, const RedLightRules &rules, PlayerField &field,
+                                const std::vector<uint64_t> &wantsMove, float dt,
+                                std::vector<RedLightEvent> &events, TickScheduler *scheduler = nullptr) {
+    AdvanceRedLightClock(state, rules, dt, events);
+
+    bool green = state.phase == PHASE_GREEN;
+    float finishTime = rules.roundTime - state.gameTimer;
+    std::vector<FieldWordEvents> &wordEvents = field.wordEvents;
+    wordEvents.resize(field.words);
+
+    auto runChunk = [&](int chunk) {
+        size_t first = chunk * WORDS_PER_CHUNK;
+        size_t last = std::min(first + WORDS_PER_CHUNK, field.words);
+        UpdateFieldWords(field, wantsMove.data(), green, rules.stepDistance, rules.glowSpeed,
+                         rules.finishX, finishTime, first, last, &wordEvents[first]);
+    };
+    int chunkCount = (int)((field.words + WORDS_PER_CHUNK - 1) / WORDS_PER_CHUNK);
+    if (scheduler) scheduler->ParallelFor(chunkCount, runChunk);
+    else for (int c = 0; c < chunkCount; c++) runChunk(c);
+
+    for (size_t w = 0; w < field.words; w++)
+        if (wordEvents[w].eliminated | wordEvents[w].finished) AppendWordEvents(w, wordEvents[w], events);
+}
+
+// ---------------------------
+// Input sources
+// ---------------------------
+
+// Bots walk on green with some probability per tick and need a per-bot reaction time to
+// stop once the doll turns, so slow bots get caught.
+class BotInput : public RedLightInput {
+public:
+    BotInput(size_t count, uint64_t seed, float moveChance = 0.8f,
+             float minReaction = 0.05f, float maxReaction = 0.5f)
+        : rng(seed, STREAM_REDLIGHT), reaction(count), moving((count + 63) / 64, 0) {
+        moveThreshold = (uint32_t)(std::min(std::max(moveChance, 0.0f), 1.0f) * 4294967295.0);
+        for (auto &r : reaction) r = minReaction + (maxReaction - minReaction) * rng.NextFloat();
+    }
+
+    void Sample(const RedLightState &state, const PlayerField &field,
+                std::vector<uint64_t> &wantsMove) override {
+        bool green = state.phase == PHASE_GREEN;
+        for (size_t w = 0; w < moving.size(); w++) {
+            uint64_t bits = 0;
+            size_t base = w * 64;
+            size_t lanes = std::min<size_t>(64, field.count - base);
+            if (green) {
+                for (size_t lane = 0; lane < lanes; lane++)
+                    bits |= (uint64_t)(rng.Next() < moveThreshold) << lane;
+            } else {
+                // Keep holding move until this bot's reaction time has passed
+                bits = moving[w];
+                for (size_t lane = 0; lane < lanes; lane++)
+                    bits &= ~((uint64_t)(state.phaseTimer >= reaction[base + lane]) << lane);
+            }
+            if (lanes < 64) bits &= (1ULL << lanes) - 1;
+            moving[w] = bits;
+            wantsMove[w] = bits;
+        }
+    }
+
+private:
+    Pcg32 rng;
+    uint32_t moveThreshold;
+    std::vector<float> reaction;
+    std::vector<uint64_t> moving;
+};
+
+// Replays a file written by RecordingInput: a uint32 player count, then one little-endian
+// bitmask of ceil(count/8) bytes per tick. Once the file runs out nobody moves.
+class ReplayFileInput : public RedLightInput {
+public:
+    explicit ReplayFileInput(const char *path) : file(fopen(path, "rb")) {
+        if (file && fread(&count, sizeof(count), 1, file) != 1) count = 0;
+    }
+    ~ReplayFileInput() override { if (file) fclose(file); }
+
+    bool IsOpen() const { return file != nullptr; }
+    uint32_t PlayerCount() const { return count; }
+
+    void Sample(const RedLightState &, const PlayerField &field,
+                std::vector<uint64_t> &wantsMove) override {
+        std::fill(wantsMove.begin(), wantsMove.end(), 0);
+        size_t bytes = (std::min<size_t>(count, field.count) + 7) / 8;
+        if (!file || fread(wantsMove.data(), 1, bytes, file) != bytes) {
+            std::fill(wantsMove.begin(), wantsMove.end(), 0);
+            return;
+        }
+        if (bytes < (count + 7) / 8) fseek(file, (long)((count + 7) / 8 - bytes), SEEK_CUR);
+    }
+
+private:
+    FILE *file;
+    uint32_t count = 0;
+};
+
+// Wraps another source and writes every sampled tick in ReplayFileInput's format
+class RecordingInput : public RedLightInput {
+public:
+    RecordingInput(RedLightInput &source, const char *path, uint32_t count)
+        : source(source), file(fopen(path, "wb")), count(count) {
+        if (file) fwrite(&count, sizeof(count), 1, file);
+    }
+    ~RecordingInput() override { if (file) fclose(file); }
+
+    void Sample(const RedLightState &state, const PlayerField &field,
+                std::vector<uint64_t> &wantsMove) override {
+        source.Sample(state, field, wantsMove);
+        if (file) fwrite(wantsMove.data(), 1, (count + 7) / 8, file);
+    }
+
+private:
+    RedLightInput &source;
+    FILE *file;
+    uint32_t count;
+};
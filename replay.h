@@ -0,0 +1,411 @@
+// Input replays
+// A replay is the run seed plus the InputFrame consumed by every simulation tick, so any game
+// can be reproduced exactly (rules are deterministic given seed + per-tick input).
+//
+// File layout: a 16-byte header, then a byte stream of records, each delta-encoded against the
+// previous tick:
+//   0x00              end of stream (also what unwritten mapped space reads as)
+//   0x01..0x3F        tick that differs from the previous one; the set bits say which fields
+//                     follow, each as a varint (mouse positions as zigzag deltas)
+//   0x40 <game>       start of a segment (one play of a mini-game); resets the previous tick
+//   0x41 key\0 value\0 run setting (see ReplaySession::Setting); only before the first segment
+//   0x80 | n          n (1..127) ticks identical to the previous one
+// An idle tick costs nothing until the run of identical ticks is flushed as one byte.
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+#include <raylib.h>
+#include "mapped_file.h"
+#include "game_input.h"
+#include "sim_clock.h"
+#include "sim_random.h"
+
+enum ReplayGame : uint8_t {
+    REPLAY_HUB,      // squid_game.cpp: a sequence of Red Light / Dalgona segments
+    REPLAY_REDLIGHT,
+    REPLAY_DALGONA,
+    REPLAY_BRIDGE,
+    REPLAY_MARBLE,
+    REPLAY_ROPE,
+    REPLAY_DOLGANA   // dolgana.cpp
+};
+
+const uint16_t REPLAY_VERSION = 2;     // 2: run settings; version 1 files still play back
+const uint16_t REPLAY_MIN_VERSION = 1;
+const size_t REPLAY_HEADER_BYTES = 16; // "SQRP", u16 version, u8 game, u8 reserved, u64 seed
+
+enum ReplayTag : uint8_t {
+    TAG_END = 0x00,
+    TAG_KEYS_DOWN = 0x01,
+    TAG_KEYS_PRESSED = 0x02,
+    TAG_MOUSE_X = 0x04,
+    TAG_MOUSE_Y = 0x08,
+    TAG_MOUSE_DOWN = 0x10,
+    TAG_MOUSE_PRESSED = 0x20,
+    TAG_SEGMENT = 0x40,
+    TAG_SETTING = 0x41,
+    TAG_REPEAT = 0x80
+};
+
+const int REPLAY_MAX_REPEAT = 127;
+
+static inline uint32_t ZigZag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t UnZigZag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// ---------------------------
+// Writer
+// ---------------------------
+
+class ReplayRecorder {
+public:
+    ~ReplayRecorder() { Close(); }
+
+    bool Open(const char *path, ReplayGame game, uint64_t seed) {
+        if (!file.Open(path)) return false;
+        uint8_t header[REPLAY_HEADER_BYTES] = {'S', 'Q', 'R', 'P',
+                                               (uint8_t)(REPLAY_VERSION & 0xFF), (uint8_t)(REPLAY_VERSION >> 8),
+                                               game, 0};
+        for (int i = 0; i < 8; i++) header[8 + i] = (uint8_t)(seed >> (8 * i));
+        file.Append(header, sizeof(header));
+        prev = InputFrame();
+        repeat = 0;
+        ticks = 0;
+        streamStarted = false;
+        return true;
+    }
+
+    bool IsOpen() const { return file.IsOpen(); }
+
+    // Ignored once the first segment or tick has been written
+    void Setting(const std::string &key, const std::string &value) {
+        if (!IsOpen() || streamStarted) return;
+        uint8_t tag = TAG_SETTING;
+        file.Append(&tag, 1);
+        file.Append(key.c_str(), key.size() + 1);
+        file.Append(value.c_str(), value.size() + 1);
+    }
+    long long Ticks() const { return ticks; }
+
+    void BeginSegment(ReplayGame game) {
+        if (!IsOpen()) return;
+        streamStarted = true;
+        FlushRepeat();
+        uint8_t record[2] = {TAG_SEGMENT, game};
+        file.Append(record, 2);
+        prev = InputFrame();
+    }
+
+    void Record(const InputFrame &in) {
+        if (!IsOpen()) return;
+        streamStarted = true;
+        ticks++;
+        uint8_t tag = 0;
+        if (in.keysDown != prev.keysDown) tag |= TAG_KEYS_DOWN;
+        if (in.keysPressed != prev.keysPressed) tag |= TAG_KEYS_PRESSED;
+        if (in.mouseX != prev.mouseX) tag |= TAG_MOUSE_X;
+        if (in.mouseY != prev.mouseY) tag |= TAG_MOUSE_Y;
+        if (in.mouseDown != prev.mouseDown) tag |= TAG_MOUSE_DOWN;
+        if (in.mousePressed != prev.mousePressed) tag |= TAG_MOUSE_PRESSED;
+        if (tag == 0) {
+            if (++repeat == REPLAY_MAX_REPEAT) FlushRepeat();
+            return;
+        }
+        FlushRepeat();
+
+        // Longest record: tag + 2 x 5-byte varints + 2 x 5-byte zigzag varints + 2 bytes
+        uint8_t record[24];
+        size_t n = 0;
+        record[n++] = tag;
+        if (tag & TAG_KEYS_DOWN) n += PutVarint(record + n, in.keysDown ^ prev.keysDown);
+        if (tag & TAG_KEYS_PRESSED) n += PutVarint(record + n, in.keysPressed);
+        if (tag & TAG_MOUSE_X) n += PutVarint(record + n, ZigZag(in.mouseX - prev.mouseX));
+        if (tag & TAG_MOUSE_Y) n += PutVarint(record + n, ZigZag(in.mouseY - prev.mouseY));
+        if (tag & TAG_MOUSE_DOWN) record[n++] = in.mouseDown;
+        if (tag & TAG_MOUSE_PRESSED) record[n++] = in.mousePressed;
+        file.Append(record, n);
+        prev = in;
+    }
+
+    void Close() {
+        if (!IsOpen()) return;
+        FlushRepeat();
+        file.Close();
+    }
+
+private:
+    static size_t PutVarint(uint8_t *out, uint32_t v) {
+        size_t n = 0;
+        while (v >= 0x80) {
+            out[n++] = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        out[n++] = (uint8_t)v;
+        return n;
+    }
+
+    void FlushRepeat() {
+        if (repeat == 0) return;
+        uint8_t record = (uint8_t)(TAG_REPEAT | repeat);
+        file.Append(&record, 1);
+        repeat = 0;
+    }
+
+    MappedAppendFile file;
+    InputFrame prev;
+    int repeat = 0;
+    long long ticks = 0;
+    bool streamStarted = false;
+};
+
+// ---------------------------
+// Reader
+// ---------------------------
+
+class ReplayReader {
+public:
+    ReplayGame game = REPLAY_HUB;
+    uint64_t seed = 0;
+
+    bool Open(const char *path) {
+        if (!file.Open(path) || file.Size() < REPLAY_HEADER_BYTES) return false;
+        const uint8_t *h = file.Data();
+        int version = h[4] | (h[5] << 8);
+        if (memcmp(h, "SQRP", 4) != 0 || version < REPLAY_MIN_VERSION || version > REPLAY_VERSION) return false;
+        game = (ReplayGame)h[6];
+        seed = 0;
+        for (int i = 0; i < 8; i++) seed |= (uint64_t)h[8 + i] << (8 * i);
+        pos = REPLAY_HEADER_BYTES;
+        prev = InputFrame();
+        repeat = 0;
+        settings.clear();
+        while (pos < file.Size() && file.Data()[pos] == TAG_SETTING) {
+            pos++;
+            std::string key, value;
+            if (!GetString(key) || !GetString(value)) return false;
+            settings.emplace_back(key, value);
+        }
+        return true;
+    }
+
+    // Recorded value of a run setting, or null if the replay has none
+    const std::string *FindSetting(const std::string &key) const {
+        for (const auto &kv : settings)
+            if (kv.first == key) return &kv.second;
+        return nullptr;
+    }
+
+    // Game of the next segment without entering it, or -1 when the stream is over.
+    // Any ticks left in the current segment are skipped.
+    int PeekSegment() {
+        while (pos < file.Size()) {
+            uint8_t tag = file.Data()[pos];
+            if (tag == TAG_END) break;
+            if (tag == TAG_SEGMENT) return pos + 1 < file.Size() ? file.Data()[pos + 1] : -1;
+            InputFrame skipped;
+            if (!Next(skipped)) break;
+        }
+        return -1;
+    }
+
+    bool BeginSegment(ReplayGame expected) {
+        if (PeekSegment() != expected) return false;
+        pos += 2;
+        prev = InputFrame();
+        repeat = 0;
+        return true;
+    }
+
+    // Input for the next tick of the current segment; false once the segment is over
+    bool Next(InputFrame &out) {
+        if (repeat > 0) {
+            repeat--;
+            out = prev;
+            return true;
+        }
+        if (pos >= file.Size()) return false;
+        const uint8_t *data = file.Data();
+        uint8_t tag = data[pos];
+        if (tag == TAG_END || tag == TAG_SEGMENT) return false;
+        pos++;
+        if (tag & TAG_REPEAT) {
+            repeat = (tag & 0x7F) - 1;
+            out = prev;
+            return true;
+        }
+
+        InputFrame in = prev;
+        if (tag & TAG_KEYS_DOWN) in.keysDown ^= GetVarint();
+        if (tag & TAG_KEYS_PRESSED) in.keysPressed = GetVarint();
+        if (tag & TAG_MOUSE_X) in.mouseX = (int16_t)(in.mouseX + UnZigZag(GetVarint()));
+        if (tag & TAG_MOUSE_Y) in.mouseY = (int16_t)(in.mouseY + UnZigZag(GetVarint()));
+        if ((tag & TAG_MOUSE_DOWN) && pos < file.Size()) in.mouseDown = data[pos++];
+        if ((tag & TAG_MOUSE_PRESSED) && pos < file.Size()) in.mousePressed = data[pos++];
+        prev = in;
+        out = in;
+        return true;
+    }
+
+private:
+    bool GetString(std::string &out) {
+        const uint8_t *data = file.Data();
+        size_t end = pos;
+        while (end < file.Size() && data[end] != 0) end++;
+        if (end >= file.Size()) return false;
+        out.assign((const char *)data + pos, end - pos);
+        pos = end + 1;
+        return true;
+    }
+
+    uint32_t GetVarint() {
+        uint32_t v = 0;
+        for (int shift = 0; pos < file.Size() && shift < 35; shift += 7) {
+            uint8_t b = file.Data()[pos++];
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        return v;
+    }
+
+    MappedReadFile file;
+    size_t pos = 0;
+    InputFrame prev;
+    int repeat = 0;
+    std::vector<std::pair<std::string, std::string>> settings;
+};
+
+// ---------------------------
+// Session: command line + per-tick plumbing shared by every game
+// ---------------------------
+
+// --record FILE   write this run's seed and input
+// --replay FILE   play FILE back at normal speed (live input takes over when it ends)
+// --fast          with --replay: run the simulation flat out, muted, drawing one frame per
+//                 FAST_FORWARD_TICKS ticks, and print how long the replay took
+class ReplaySession {
+public:
+    static const int FAST_FORWARD_TICKS = 2000;
+    static const int NORMAL_FPS = 60;
+
+    // Parses the flags and returns the run seed: the recorded one when replaying, else
+    // ChooseRunSeed's. Call after InitWindow/InitAudioDevice.
+    uint64_t Start(int argc, char **argv, ReplayGame game) {
+        const char *recordPath = nullptr;
+        const char *replayPath = nullptr;
+        for (int i = 1; i < argc; i++) {
+            bool hasValue = i + 1 < argc;
+            if (!strcmp(argv[i], "--record") && hasValue) recordPath = argv[++i];
+            else if (!strcmp(argv[i], "--replay") && hasValue) replayPath = argv[++i];
+            else if (!strcmp(argv[i], "--fast")) fast = true;
+        }
+
+        if (replayPath) {
+            if (reader.Open(replayPath) && reader.game == game) {
+                replaying = true;
+                printf("Replaying %s (seed %llu)\n", replayPath, (unsigned long long)reader.seed);
+                if (fast) {
+                    SetTargetFPS(0);
+                    if (IsAudioDeviceReady()) SetMasterVolume(0.0f);
+                }
+                startTime = std::chrono::steady_clock::now();
+                return reader.seed;
+            }
+            printf("Cannot replay %s: missing, corrupt or recorded by another game\n", replayPath);
+        }
+
+        uint64_t seed = ChooseRunSeed(argc, argv);
+        if (recordPath) {
+            if (recorder.Open(recordPath, game, seed)) printf("Recording input to %s\n", recordPath);
+            else printf("Cannot record to %s\n", recordPath);
+        }
+        return seed;
+    }
+
+    ~ReplaySession() { recorder.Close(); }
+
+    bool Replaying() const { return replaying; }
+    bool FastForward() const { return replaying && fast; }
+
+    // A run setting that changes the simulation without being input (e.g. --marble-ai): stored
+    // in the recording, and on replay the recorded value replaces value. Replays made before
+    // the setting existed get legacy, what those runs used. Call after Start() and before the
+    // first segment.
+    std::string Setting(const std::string &key, const std::string &value, const std::string &legacy) {
+        if (replaying) {
+            const std::string *recorded = reader.FindSetting(key);
+            return recorded ? *recorded : legacy;
+        }
+        recorder.Setting(key, value);
+        return value;
+    }
+
+    // Game of the next recorded segment (-1 if none); lets the hub skip its menus on replay
+    int PeekSegment() {
+        if (!replaying) return -1;
+        int next = reader.PeekSegment();
+        if (next < 0) Finish();
+        return next;
+    }
+
+    // Call when a mini-game starts its tick loop
+    void BeginSegment(ReplayGame game) {
+        if (replaying && !reader.BeginSegment(game)) Finish();
+        recorder.BeginSegment(game);
+    }
+
+    // Replaces clock.Advance(GetFrameTime()) in tick loops
+    int StepsThisFrame(FixedStepClock &clock) { return StepsThisFrame(clock, GetFrameTime()); }
+
+    // Same, for loops that measure their own frame time
+    int StepsThisFrame(FixedStepClock &clock, double frameTime) {
+        if (!FastForward()) return clock.Advance(frameTime);
+        clock.tick += FAST_FORWARD_TICKS;
+        return FAST_FORWARD_TICKS;
+    }
+
+    // Replaces latch.Consume() in tick loops. When a segment runs out the game gets empty
+    // input until it ends; when the whole replay runs out the player takes over.
+    InputFrame NextInput(InputLatch &latch) {
+        if (replaying) {
+            InputFrame in;
+            if (reader.Next(in)) {
+                last = in;
+                replayedTicks++;
+                return in;
+            }
+            if (reader.PeekSegment() >= 0) return InputFrame();
+            Finish();
+        }
+        InputFrame in = latch.Consume();
+        recorder.Record(in);
+        return in;
+    }
+
+    // Input to use for hover highlights between ticks
+    const InputFrame &Preview(const InputLatch &latch) const { return replaying ? last : latch.Peek(); }
+
+private:
+    void Finish() {
+        if (!replaying) return;
+        replaying = false;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        printf("Replay finished: %lld ticks in %.3f s (%.0f ticks/s)\n",
+               replayedTicks, seconds, seconds > 0 ? replayedTicks / seconds : 0.0);
+        if (fast) {
+            SetTargetFPS(NORMAL_FPS);
+            if (IsAudioDeviceReady()) SetMasterVolume(1.0f);
+        }
+    }
+
+    ReplayRecorder recorder;
+    ReplayReader reader;
+    InputFrame last;
+    bool replaying = false;
+    bool fast = false;
+    long long replayedTicks = 0;
+    std::chrono::steady_clock::time_point startTime;
+};
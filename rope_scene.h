@@ -0,0 +1,176 @@
+// Tug of War scene
+// Two players mash A and L; the pull difference over each half second moves the rope.
+// Hosted by pullrope.cpp on its own or by the squid_game hub.
+#pragma once
+#include <raylib.h>
+#include <string>
+#include "scene.h"
+
+class RopeScene : public Scene {
+public:
+    // Input bindings (bit index in InputFrame)
+    enum RopeInput { IN_PULL_P1, IN_PULL_P2, IN_RESTART };
+
+    ReplayGame ReplayId() const override { return REPLAY_ROPE; }
+    std::vector<int> Bindings() const override { return {KEY_A, KEY_L, KEY_R}; }
+
+    bool Init(const SceneContext &ctx) override {
+        screenWidth = ctx.width;
+        screenHeight = ctx.height;
+
+        assets = ctx.assets;
+        results = ctx.results;
+        playerNames[0] = ctx.playerName;
+        playerNames[1] = ctx.rivalName;
+
+        if (assets) {
+            // Load rope image
+            ropeSprite = assets->AcquireSprite("rope.png");
+
+            // Player images (if missing, use colored rectangles instead)
+            p1Sprite = assets->AcquireSprite("456.png");
+            p2Sprite = assets->AcquireSprite("333.png");
+        }
+
+        // Rope properties
+        ropeWidth = ropeSprite.Width();
+        ropeHeight = ropeSprite.Height();
+        ropeY = screenHeight / 2.0f - ropeHeight / 2.0f;
+
+        // Player properties
+        playerY = ropeY + ropeHeight / 2.0f - 50; // center vertically
+        return true;
+    }
+
+    void Enter() override {
+        ropeX = prevRopeX = screenWidth / 2.0f;
+        player1Pulls = 0;
+        player2Pulls = 0;
+        gameOver = false;
+        winnerText = "";
+        pullResetTicks = 0;
+    }
+
+    void Update(const InputFrame &in) override {
+        prevRopeX = ropeX;
+
+        if (!gameOver) {
+            pullResetTicks++;
+
+            // Reset pulls every 0.5 seconds
+            if (pullResetTicks >= pullWindowTicks) {
+                pullResetTicks = 0;
+                player1Pulls = 0;
+                player2Pulls = 0;
+            }
+
+            if (in.Pressed(IN_PULL_P1)) player1Pulls++;
+            if (in.Pressed(IN_PULL_P2)) player2Pulls++;
+
+            int diff = player2Pulls - player1Pulls;
+            ropeSpeed = diff * pullForce;
+            ropeX += ropeSpeed;
+
+            // Check game over
+            if (ropeX < ropeWidth / 2) {
+                ropeX = ropeWidth / 2;
+                gameOver = true;
+                winnerText = "Player 1 Wins!";
+                RecordWinner(0);
+            } else if (ropeX > screenWidth - ropeWidth / 2) {
+                ropeX = screenWidth - ropeWidth / 2;
+                gameOver = true;
+                winnerText = "Player 2 Wins!";
+                RecordWinner(1);
+            }
+        } else if (in.Pressed(IN_RESTART)) {
+            Enter();
+        }
+    }
+
+    void Draw(float alpha, const InputFrame &) override {
+        float drawRopeX = Lerp(prevRopeX, ropeX, alpha);
+
+        ClearBackground(RAYWHITE);
+
+        // Player areas
+        DrawRectangle(0, 0, screenWidth / 2, screenHeight, LIGHTGRAY);
+        DrawRectangle(screenWidth / 2, 0, screenWidth / 2, screenHeight, LIGHTGRAY);
+
+        // Player 1 label
+        DrawText("Player 1", 50, 30, 30, RED);
+        DrawText("Press 'A' rapidly!", 20, 70, 20, DARKGRAY);
+
+        // Player 2 label
+        DrawText("Player 2", screenWidth / 2 + 50, 30, 30, BLUE);
+        DrawText("Press 'L' rapidly!", screenWidth / 2 + 20, 70, 20, DARKGRAY);
+
+        // Center divider
+        DrawLine(screenWidth / 2, 0, screenWidth / 2, screenHeight, DARKGRAY);
+
+        // Draw rope
+        DrawSprite(ropeSprite, {drawRopeX - ropeWidth / 2, ropeY, ropeWidth, ropeHeight}, WHITE);
+
+        // Draw players
+        float p1X = drawRopeX - ropeWidth / 2 - playerWidth - 10;
+        float p2X = drawRopeX + ropeWidth / 2 + 10;
+
+        if (p1Sprite.Valid()) {
+            DrawSprite(p1Sprite, {p1X, playerY, playerWidth, playerHeight}, WHITE);
+        } else {
+            DrawRectangle(p1X, playerY, playerWidth, playerHeight, RED);
+        }
+
+        if (p2Sprite.Valid()) {
+            DrawSprite(p2Sprite, {p2X, playerY, playerWidth, playerHeight}, WHITE);
+        } else {
+            DrawRectangle(p2X, playerY, playerWidth, playerHeight, BLUE);
+        }
+
+        // Winner text
+        if (gameOver) {
+            int textWidth = MeasureText(winnerText.c_str(), 40);
+            DrawText(winnerText.c_str(), screenWidth / 2 - textWidth / 2, screenHeight / 2 + 100, 40, BLACK);
+            DrawText("Press R to Restart", screenWidth / 2 - 100, screenHeight / 2 + 150, 25, DARKGRAY);
+        }
+    }
+
+    // Once the rope has settled on the winner's side
+    int IdleTicks() const override { return gameOver && prevRopeX == ropeX ? SCENE_IDLE_UNTIL_INPUT : 0; }
+
+    void Shutdown() override {
+        if (!assets) return;
+        for (const char *file : {"rope.png", "456.png", "333.png"}) assets->Release(file);
+    }
+
+private:
+    void RecordWinner(int winner) {
+        if (!results) return;
+        results->Record(REPLAY_ROPE, playerNames[winner].c_str(), RESULT_WON);
+        results->Record(REPLAY_ROPE, playerNames[1 - winner].c_str(), RESULT_LOST);
+    }
+
+    AssetCache *assets = nullptr;
+    TournamentResults *results = nullptr;
+    std::string playerNames[2]; // left (456's portrait) and right (333's)
+    int screenWidth = 0, screenHeight = 0;
+    Sprite ropeSprite; // from the host's atlas when it has one
+    Sprite p1Sprite, p2Sprite;
+
+    float ropeX = 0, prevRopeX = 0;
+    float ropeWidth = 0, ropeHeight = 0, ropeY = 0;
+    float playerY = 0;
+    const float playerWidth = 60;
+    const float playerHeight = 100;
+
+    // Pull counts and speed
+    int player1Pulls = 0;
+    int player2Pulls = 0;
+    float ropeSpeed = 0.0f;
+    const float pullForce = 2.5f;
+
+    const int pullWindowTicks = FixedStepClock().TicksFor(0.5); // pulls are counted in half-second windows
+    int pullResetTicks = 0;
+    bool gameOver = false;
+    std::string winnerText;
+};
@@ -0,0 +1,113 @@
+// Mini-game scenes
+// A scene is one mini-game's state and rules behind a common interface, so the same code runs
+// as a standalone program or inside the squid_game hub window. The host owns the window, the
+// audio device and shared textures; RunScene() drives a scene on the fixed tick with replay
+// support until the window closes or the host's back key is pressed.
+#pragma once
+#include <raylib.h>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "game_input.h"
+#include "sim_clock.h"
+#include "replay.h"
+#include "asset_cache.h"
+#include "tournament_results.h"
+#include "frame_profiler.h"
+#include "frame_pacer.h"
+
+const int SCENE_IDLE_UNTIL_INPUT = INT_MAX;
+
+// What the host lends a scene
+struct SceneContext {
+    int width = 0;
+    int height = 0;
+    uint64_t seed = 0;             // run seed; each scene derives its own Pcg32 stream
+    AssetCache *assets = nullptr;  // shared with the host; scenes acquire in Init, release in Shutdown.
+                                   // Null for headless runs (squid_bench): rules only, no textures or sounds.
+    TournamentResults *results = nullptr; // where finished rounds are reported; null while
+                                          // replaying and for headless runs
+    std::string playerName = RESULTS_DEFAULT_PLAYER; // contestant number results are recorded under
+    std::string rivalName = RESULTS_DEFAULT_RIVAL;   // the second player's, in two-player scenes
+};
+
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    virtual ReplayGame ReplayId() const = 0;
+    // Keys reported as bits 0..n-1 of the InputFrame passed to Update
+    virtual std::vector<int> Bindings() const = 0;
+
+    // Once per host: acquire the scene's assets. Returns false if it can't run.
+    virtual bool Init(const SceneContext &ctx) = 0;
+    // Every time the scene is entered: start a fresh game
+    virtual void Enter() = 0;
+    // One fixed simulation tick
+    virtual void Update(const InputFrame &in) = 0;
+    // One rendered frame (inside BeginDrawing); alpha interpolates between ticks and
+    // preview is the input to use for hover effects
+    virtual void Draw(float alpha, const InputFrame &preview) = 0;
+    // Ticks the scene will keep drawing the same picture if no input arrives: 0 while anything
+    // animates, SCENE_IDLE_UNTIL_INPUT when only input can change it. Lets the host sleep.
+    virtual int IdleTicks() const { return 0; }
+    // Once per host: release what Init acquired
+    virtual void Shutdown() = 0;
+};
+
+// Run a scene until the window closes or backKey (KEY_NULL for none) is pressed; backHint is
+// drawn in the corner while it runs. The back key is latched like any other binding, so a
+// replay leaves the scene on the same tick.
+static inline void RunScene(Scene &scene, ReplaySession &replay, int backKey = KEY_NULL,
+                            const char *backHint = nullptr) {
+    std::vector<int> keys = scene.Bindings();
+    int backBinding = -1;
+    if (backKey != KEY_NULL) {
+        backBinding = (int)keys.size();
+        keys.push_back(backKey);
+    }
+    InputLatch latch(keys);
+    FixedStepClock clock;
+    scene.Enter();
+    replay.BeginSegment(scene.ReplayId());
+
+    // Frame time is measured here rather than read from GetFrameTime(), which lags a frame and
+    // would count an idle wait twice
+    const int maxSteps = clock.maxStepsPerFrame;
+    double frameStart = GetTime();
+    int idleTicks = 0;
+    bool leaving = false;
+    while (!leaving && !WindowShouldClose()) {
+        PROFILE_BEGIN("input");
+        latch.Poll();
+        PROFILE_END();
+        PROFILE_BEGIN("update");
+        // After sleeping, run the ticks slept through (all of a timed pause, up to a second of an
+        // open-ended one) instead of dropping them like a stall
+        double now = GetTime();
+        int catchUp = idleTicks == SCENE_IDLE_UNTIL_INPUT ? clock.TicksFor(1.0) : idleTicks;
+        clock.maxStepsPerFrame = maxSteps + catchUp;
+        int steps = replay.StepsThisFrame(clock, now - frameStart);
+        frameStart = now;
+        for (int s = 0; s < steps && !leaving; s++) {
+            InputFrame in = replay.NextInput(latch);
+            if (backBinding >= 0 && in.Pressed(backBinding)) leaving = true;
+            else scene.Update(in);
+        }
+        PROFILE_END();
+
+        BeginDrawing();
+        PROFILE_BEGIN("draw");
+        scene.Draw(clock.Alpha(), replay.Preview(latch));
+        if (backHint) DrawText(backHint, 10, GetScreenHeight() - 24, 18, DARKGRAY);
+        PROFILE_END();
+        PROFILE_FRAME();
+        // A replay feeds input without window events, so it never waits for them
+        idleTicks = replay.Replaying() ? 0 : scene.IdleTicks();
+        Pacer().Idle(idleTicks == SCENE_IDLE_UNTIL_INPUT ? IDLE_UNTIL_INPUT
+                                                         : idleTicks * clock.step - clock.accumulator);
+        EndDrawing();
+    }
+    Pacer().Resume();
+}
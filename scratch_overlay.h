@@ -0,0 +1,86 @@
+// Dalgona scratch overlay
+// Keeps the scratched-pixel visualization in a GPU texture that is patched incrementally:
+// tiles of the scratch mask that changed are written to a CPU copy and only the dirty
+// sub-rectangle is uploaded, then the whole overlay is drawn as one textured quad.
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <algorithm>
+#include "tiled_bitset.h"
+
+struct ScratchOverlay {
+    int width = 0;
+    int height = 0;
+    Color color = BLANK;         // color of a scratched pixel
+    Texture2D texture = {};
+    std::vector<Color> pixels;   // CPU copy of the texture contents
+    std::vector<Color> staging;  // contiguous buffer for the dirty sub-rectangle upload
+    bool dirty = false;
+    int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = 0, dirtyY1 = 0; // inclusive bounds
+};
+
+static inline ScratchOverlay LoadScratchOverlay(int width, int height, Color color) {
+    ScratchOverlay overlay;
+    overlay.width = width;
+    overlay.height = height;
+    overlay.color = color;
+    overlay.pixels.assign((size_t)width * height, BLANK);
+
+    Image img = GenImageColor(width, height, BLANK);
+    overlay.texture = LoadTextureFromImage(img);
+    UnloadImage(img);
+    SetTextureFilter(overlay.texture, TEXTURE_FILTER_POINT); // keep scratched pixels crisp when scaled
+    return overlay;
+}
+
+static inline void UnloadScratchOverlay(ScratchOverlay &overlay) {
+    UnloadTexture(overlay.texture);
+    overlay.texture = {};
+    overlay.pixels.clear();
+    overlay.staging.clear();
+}
+
+// Copy the tiles of `scratched` that changed since the last flush into the overlay and
+// upload the rectangle that covers them
+static inline void FlushScratchOverlay(ScratchOverlay &overlay, TiledBitset &scratched) {
+    overlay.dirty = false;
+    scratched.ConsumeDirtyTiles([&](int tile) {
+        int tx = (tile % scratched.tilesX) * TILE_SIZE;
+        int ty = (tile / scratched.tilesX) * TILE_SIZE;
+        uint64_t bits = scratched.tiles[tile];
+        for (int b = 0; b < 64; b++) {
+            int x = tx + b % TILE_SIZE, y = ty + b / TILE_SIZE;
+            if (x >= overlay.width || y >= overlay.height) continue;
+            overlay.pixels[y * overlay.width + x] = ((bits >> b) & 1) ? overlay.color : BLANK;
+        }
+        int x1 = std::min(tx + TILE_SIZE, overlay.width) - 1;
+        int y1 = std::min(ty + TILE_SIZE, overlay.height) - 1;
+        if (!overlay.dirty) {
+            overlay.dirty = true;
+            overlay.dirtyX0 = tx; overlay.dirtyY0 = ty;
+            overlay.dirtyX1 = x1; overlay.dirtyY1 = y1;
+        } else {
+            overlay.dirtyX0 = std::min(overlay.dirtyX0, tx);
+            overlay.dirtyY0 = std::min(overlay.dirtyY0, ty);
+            overlay.dirtyX1 = std::max(overlay.dirtyX1, x1);
+            overlay.dirtyY1 = std::max(overlay.dirtyY1, y1);
+        }
+    });
+    if (!overlay.dirty) return;
+
+    int rw = overlay.dirtyX1 - overlay.dirtyX0 + 1;
+    int rh = overlay.dirtyY1 - overlay.dirtyY0 + 1;
+    overlay.staging.resize((size_t)rw * rh);
+    for (int y = 0; y < rh; y++) {
+        const Color *src = &overlay.pixels[(overlay.dirtyY0 + y) * overlay.width + overlay.dirtyX0];
+        std::copy(src, src + rw, &overlay.staging[(size_t)y * rw]);
+    }
+    UpdateTextureRec(overlay.texture,
+                     Rectangle{(float)overlay.dirtyX0, (float)overlay.dirtyY0, (float)rw, (float)rh},
+                     overlay.staging.data());
+    overlay.dirty = false;
+}
+
+static inline void DrawScratchOverlay(const ScratchOverlay &overlay, Vector2 position, float scale) {
+    DrawTextureEx(overlay.texture, position, 0.0f, scale, WHITE);
+}
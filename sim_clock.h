@@ -0,0 +1,41 @@
+// Fixed-timestep simulation clock
+// Game rules advance in whole ticks of a fixed length no matter how long a rendered frame
+// took; rendering interpolates between the last two ticks with Alpha().
+#pragma once
+#include <cmath>
+
+const double SIM_TICK_RATE = 60.0; // ticks per second shared by every mini-game
+
+struct FixedStepClock {
+    double step;
+    double accumulator = 0.0;
+    long long tick = 0;
+    int maxStepsPerFrame = 8; // after a long stall, drop time instead of spiralling
+
+    explicit FixedStepClock(double tickRate = SIM_TICK_RATE) : step(1.0 / tickRate) {}
+
+    // Feed the real frame time; returns how many ticks to simulate this frame
+    int Advance(double frameTime) {
+        accumulator += frameTime;
+        int steps = (int)(accumulator / step);
+        if (steps > maxStepsPerFrame) {
+            steps = maxStepsPerFrame;
+            accumulator = std::fmod(accumulator, step);
+        } else {
+            accumulator -= steps * step;
+        }
+        tick += steps;
+        return steps;
+    }
+
+    void Reset() {
+        accumulator = 0.0;
+        tick = 0;
+    }
+
+    float Dt() const { return (float)step; }
+    float Alpha() const { return (float)(accumulator / step); } // 0..1 between previous and current tick
+    int TicksFor(double seconds) const { return (int)std::lround(seconds / step); }
+};
+
+static inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
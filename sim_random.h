@@ -0,0 +1,65 @@
+// Seedable random streams
+// PCG32 (O'Neill) generators: every mini-game draws from its own stream of one run seed, so a
+// run can be reproduced from the seed and its input log, and games never disturb each other.
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+enum SimStream : uint64_t {
+    STREAM_REDLIGHT = 1,
+    STREAM_DALGONA,
+    STREAM_BRIDGE,
+    STREAM_MARBLE,
+    STREAM_ROPE
+};
+
+struct Pcg32 {
+    uint64_t state = 0;
+    uint64_t inc = 1;
+
+    Pcg32() { Seed(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL); }
+    Pcg32(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    void Seed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        inc = (stream << 1u) | 1u;
+        Next();
+        state += seed;
+        Next();
+    }
+
+    uint32_t Next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    // Uniform in [0, bound) without modulo bias
+    uint32_t Range(uint32_t bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            uint32_t r = Next();
+            if (r >= threshold) return r % bound;
+        }
+    }
+
+    float NextFloat() { return (Next() >> 8) * (1.0f / 16777216.0f); } // [0, 1)
+    bool Chance(float p) { return NextFloat() < p; }
+};
+
+// Run seed from --seed N, else the SQUID_SEED environment variable, else the clock.
+// The seed is printed so any run can be reproduced.
+static inline uint64_t ChooseRunSeed(int argc, char **argv) {
+    uint64_t seed = (uint64_t)time(nullptr);
+    const char *env = getenv("SQUID_SEED");
+    if (env && *env) seed = strtoull(env, nullptr, 10);
+    for (int i = 1; i + 1 < argc; i++)
+        if (!strcmp(argv[i], "--seed")) seed = strtoull(argv[i + 1], nullptr, 10);
+    printf("Run seed: %llu\n", (unsigned long long)seed);
+    return seed;
+}
@@ -0,0 +1,229 @@
+// Sprite atlas and batcher
+// SpriteAtlas packs many images into one texture with a shelf packer, so the sprites cut from it
+// can be drawn back to back without a texture switch breaking raylib's batch. SpriteBatch queues a
+// frame's sprites in draw order and submits each run that shares a texture as one quad stream.
+#pragma once
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "frame_profiler.h"
+
+const int SPRITE_ATLAS_MAX_SIZE = 4096; // widest/tallest atlas texture we build
+const int SPRITE_ATLAS_PADDING = 2;     // pixels between packed images, half of it edge-extruded
+
+// A rectangle of a texture: a whole loose texture or one image in an atlas
+struct Sprite {
+    Texture2D texture = {};
+    Rectangle source = {};
+
+    bool Valid() const { return texture.id != 0; }
+    float Width() const { return source.width; }
+    float Height() const { return source.height; }
+};
+
+static inline Sprite SpriteOf(Texture2D texture) {
+    return {texture, {0, 0, (float)texture.width, (float)texture.height}};
+}
+
+static inline void DrawSprite(const Sprite &sprite, Rectangle dest, Color tint) {
+    DrawTexturePro(sprite.texture, sprite.source, dest, {0, 0}, 0.0f, tint);
+}
+
+// Rows ("shelves") filled left to right; images go in tallest first, so each shelf is as tall as
+// its first image and the rest of it wastes little height
+class ShelfPacker {
+public:
+    explicit ShelfPacker(int width) : width(width) {}
+
+    bool Place(int w, int h, int &x, int &y) {
+        if (w > width) return false;
+        if (cursorX + w > width) {
+            shelfY += shelfHeight;
+            cursorX = 0;
+            shelfHeight = 0;
+        }
+        x = cursorX;
+        y = shelfY;
+        cursorX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        return true;
+    }
+
+    int Height() const { return shelfY + shelfHeight; }
+
+private:
+    int width;
+    int cursorX = 0, shelfY = 0, shelfHeight = 0;
+};
+
+class SpriteAtlas {
+public:
+    SpriteAtlas() = default;
+    SpriteAtlas(const SpriteAtlas &) = delete;
+    SpriteAtlas &operator=(const SpriteAtlas &) = delete;
+    ~SpriteAtlas() {
+        DropPending();
+    }
+
+    // Queue a copy of img for the next Build(); name is how its sprite is found again
+    void Add(const std::string &name, const Image &img) {
+        if (!img.data || img.width <= 0 || img.height <= 0) return;
+        Image copy = ImageCopy(img);
+        if (copy.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) ImageFormat(&copy, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        pending.push_back({name, copy});
+    }
+
+    bool HasPending() const { return !pending.empty(); }
+
+    // Main thread: pack everything queued into one texture, replacing any earlier one. Returns
+    // false if the images would not fit in maxSize x maxSize. The queue is emptied either way.
+    // A replaced texture stays loaded until Unload(): sprites found in it are still drawn.
+    bool Build(int maxSize = SPRITE_ATLAS_MAX_SIZE) {
+        PROFILE_SCOPE("atlas build");
+        if (pending.empty()) return texture.id != 0;
+        std::vector<Pending *> order;
+        for (Pending &p : pending) order.push_back(&p);
+        std::sort(order.begin(), order.end(), [](const Pending *a, const Pending *b) {
+            return a->image.height != b->image.height ? a->image.height > b->image.height : a->name < b->name;
+        });
+
+        // Narrowest power-of-two width that keeps the atlas roughly square
+        long long area = 0;
+        int widest = 0;
+        for (Pending *p : order) {
+            area += (long long)(p->image.width + SPRITE_ATLAS_PADDING) * (p->image.height + SPRITE_ATLAS_PADDING);
+            widest = std::max(widest, p->image.width + SPRITE_ATLAS_PADDING);
+        }
+        int width = 256;
+        while (width < maxSize && ((long long)width * width < area || width < widest)) width *= 2;
+
+        ShelfPacker packer(width);
+        std::vector<Rectangle> placed(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            int x, y;
+            const Image &img = order[i]->image;
+            if (!packer.Place(img.width + SPRITE_ATLAS_PADDING, img.height + SPRITE_ATLAS_PADDING, x, y)) return DropPending();
+            placed[i] = {(float)(x + SPRITE_ATLAS_PADDING / 2), (float)(y + SPRITE_ATLAS_PADDING / 2),
+                         (float)img.width, (float)img.height};
+        }
+        int height = packer.Height();
+        if (height > maxSize) return DropPending();
+
+        Image atlas = GenImageColor(width, height, BLANK);
+        Color *dst = (Color *)atlas.data;
+        for (size_t i = 0; i < order.size(); i++) {
+            const Image &img = order[i]->image;
+            const Color *src = (const Color *)img.data;
+            int x0 = (int)placed[i].x, y0 = (int)placed[i].y;
+            // Copy with the border extruded by one pixel so filtering never samples a neighbour
+            for (int y = -1; y <= img.height; y++) {
+                int sy = std::clamp(y, 0, img.height - 1);
+                if (y0 + y < 0 || y0 + y >= height) continue;
+                Color *row = dst + (size_t)(y0 + y) * width + x0;
+                memcpy(row, src + (size_t)sy * img.width, (size_t)img.width * sizeof(Color));
+                if (x0 > 0) row[-1] = row[0];
+                if (x0 + img.width < width) row[img.width] = row[img.width - 1];
+            }
+        }
+        Texture2D packed = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+        if (packed.id == 0) return DropPending();
+
+        if (texture.id != 0) retired.push_back(texture);
+        texture = packed;
+        regions.clear();
+        for (size_t i = 0; i < order.size(); i++) regions[order[i]->name] = placed[i];
+        DropPending();
+        return true;
+    }
+
+    // Invalid sprite if name was never packed
+    Sprite Find(const std::string &name) const {
+        auto it = regions.find(name);
+        if (it == regions.end() || texture.id == 0) return {};
+        return {texture, it->second};
+    }
+
+    void Unload() {
+        if (texture.id != 0) UnloadTexture(texture);
+        for (Texture2D &old : retired) UnloadTexture(old);
+        retired.clear();
+        texture = {};
+        regions.clear();
+    }
+
+    Texture2D texture = {};
+
+private:
+    bool DropPending() {
+        for (Pending &p : pending) UnloadImage(p.image);
+        pending.clear();
+        return false;
+    }
+
+    struct Pending {
+        std::string name;
+        Image image; // RGBA8, owned
+    };
+    std::vector<Pending> pending;
+    std::vector<Texture2D> retired; // earlier builds, still referenced by their sprites
+    std::unordered_map<std::string, Rectangle> regions;
+};
+
+// Queues sprites in draw order; Flush() sends every run of consecutive sprites that share a
+// texture as one rlgl quad stream. Sprites from one atlas are therefore a single run however
+// many there are, as long as no other drawing is interleaved with them before the flush.
+class SpriteBatch {
+public:
+    void Draw(const Sprite &sprite, Rectangle dest, Color tint) {
+        if (!sprite.Valid()) return;
+        quads.push_back({sprite.texture, sprite.source, dest, tint});
+    }
+
+    // Centered on pos, scaled
+    void DrawCentered(const Sprite &sprite, Vector2 pos, float scale, Color tint) {
+        float w = sprite.Width() * scale, h = sprite.Height() * scale;
+        Draw(sprite, {pos.x - w / 2, pos.y - h / 2, w, h}, tint);
+    }
+
+    void Flush() {
+        int runs = 0;
+        for (size_t i = 0; i < quads.size();) {
+            const Texture2D &tex = quads[i].texture;
+            float invW = 1.0f / tex.width, invH = 1.0f / tex.height;
+            rlSetTexture(tex.id);
+            rlBegin(RL_QUADS);
+            for (; i < quads.size() && quads[i].texture.id == tex.id; i++) {
+                const Quad &q = quads[i];
+                rlCheckRenderBatchLimit(4); // flushes (keeping texture and mode) when rlgl's buffer is full
+                float u0 = q.source.x * invW, v0 = q.source.y * invH;
+                float u1 = (q.source.x + q.source.width) * invW, v1 = (q.source.y + q.source.height) * invH;
+                float x0 = q.dest.x, y0 = q.dest.y, x1 = q.dest.x + q.dest.width, y1 = q.dest.y + q.dest.height;
+                rlColor4ub(q.tint.r, q.tint.g, q.tint.b, q.tint.a);
+                rlNormal3f(0.0f, 0.0f, 1.0f);
+                rlTexCoord2f(u0, v0); rlVertex2f(x0, y0);
+                rlTexCoord2f(u0, v1); rlVertex2f(x0, y1);
+                rlTexCoord2f(u1, v1); rlVertex2f(x1, y1);
+                rlTexCoord2f(u1, v0); rlVertex2f(x1, y0);
+            }
+            rlEnd();
+            runs++;
+        }
+        rlSetTexture(0);
+        PROFILE_COUNT("sprites", (int)quads.size());
+        PROFILE_COUNT("sprite runs", runs);
+        quads.clear();
+    }
+
+private:
+    struct Quad {
+        Texture2D texture;
+        Rectangle source, dest;
+        Color tint;
+    };
+    std::vector<Quad> quads;
+};
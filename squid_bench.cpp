@@ -0,0 +1,467 @@
+// Benchmark suite
+// Runs fixed, seeded scenarios through the real game rules with no window or audio and
+// reports throughput and per-operation latency percentiles as JSON. With --baseline it
+// compares against an earlier report and exits non-zero on a regression.
+//
+//   g++ -std=c++17 -O2 -pthread squid_bench.cpp -o squid_bench -lraylib
+//   ./squid_bench > bench_baseline.json
+//   ./squid_bench --baseline bench_baseline.json > bench_latest.json
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "redlight_sim.h"
+#include "dalgona_outline.h"
+#include "cookie_shapes.h"
+#include "bridge_scene.h"
+#include "marble_scene.h"
+#include "rope_scene.h"
+
+const int BENCH_REPORT_VERSION = 1;
+const char *const DALGONA_SHAPES[] = {"circle.png", "triangle.png", "umbrella.png", "star.png"};
+const int DALGONA_SCRATCH_RADIUS = 2;       // ALLOWED_RADIUS_* in squid_game.cpp
+const int COOKIE_BENCH_SIZE = 432;          // cookie size in the hub at 1280x720
+const int DALGONA_OUTLINE_THRESHOLD = 110;  // dark-line threshold for the cookie images
+const double P99_NOISE_FLOOR_US = 1.0;      // p99 changes smaller than this are timer noise
+
+struct BenchResult {
+    std::string name;
+    const char *unit;        // what one operation is
+    long long ops = 0;
+    double seconds = 0.0;
+    double p50 = 0, p90 = 0, p99 = 0, max = 0; // microseconds per operation
+    unsigned long long checksum = 0;          // outcome of the run (0: not tracked); must not change with speed
+
+    double OpsPerSec() const { return seconds > 0 ? ops / seconds : 0.0; }
+};
+
+// Times each operation individually so percentiles reflect single-tick latency
+class OpTimer {
+public:
+    void Reserve(size_t n) { samples.reserve(n); }
+
+    template <typename Fn>
+    void Run(Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void Finish(BenchResult &r) {
+        r.ops = (long long)samples.size();
+        r.seconds = 0.0;
+        for (double us : samples) r.seconds += us / 1e6;
+        if (samples.empty()) return;
+        std::sort(samples.begin(), samples.end());
+        auto at = [&](double p) { return samples[(size_t)(p * (samples.size() - 1) + 0.5)]; };
+        r.p50 = at(0.50);
+        r.p90 = at(0.90);
+        r.p99 = at(0.99);
+        r.max = samples.back();
+    }
+
+private:
+    std::vector<double> samples;
+};
+
+static inline void MixHash(unsigned long long &h, unsigned long long v) {
+    for (int i = 0; i < 8; i++, v >>= 8) h = (h ^ (v & 0xff)) * 1099511628211ULL;
+}
+
+// ---------------------------
+// Scenarios
+// ---------------------------
+
+static BenchResult BenchRedLight(int players, int rounds, uint64_t seed) {
+    BenchResult r = {"redlight_" + std::to_string(players), "tick"};
+    RedLightRules rules;
+    PlayerField field;
+    field.Resize(players);
+    BotInput bots(players, seed, 0.8f);
+    std::vector<uint64_t> wantsMove(field.words, 0);
+    std::vector<RedLightEvent> events;
+    RedLightState state;
+    const float dt = 1.0f / (float)SIM_TICK_RATE;
+
+    OpTimer timer;
+    r.checksum = 1469598103934665603ULL;
+    for (int round = 0; round < rounds; round++) {
+        StartRedLight(state, rules, field, 80.0f);
+        while (!IsRedLightOver(state, field)) {
+            timer.Run([&] {
+                bots.Sample(state, field, wantsMove);
+                events.clear();
+                StepRedLight(state, rules, field, wantsMove, dt, events);
+            });
+            for (const RedLightEvent &e : events) MixHash(r.checksum, (unsigned long long)e.type << 32 | (unsigned)e.player);
+        }
+    }
+    timer.Finish(r);
+    return r;
+}
+
+const OutlineRule DALGONA_OUTLINE_RULE = {LUMA_REC709, DALGONA_OUTLINE_THRESHOLD, true};
+
+// Outline preprocessing from decoded pixels (what a cold cache costs)
+static bool BenchDalgonaOutline(const char *file, int repeats, BenchResult &r, OutlineField &field) {
+    Image img = LoadImage(file);
+    if (!img.data) return false;
+    ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    r = {std::string("dalgona_outline_") + GetFileNameWithoutExt(file), "build"};
+    OpTimer timer;
+    for (int i = 0; i < repeats; i++)
+        timer.Run([&] { field = BuildOutlineField((const Color *)img.data, img.width, img.height, DALGONA_OUTLINE_RULE); });
+    timer.Finish(r);
+    r.checksum = (unsigned long long)field.outlinePixels;
+    UnloadImage(img);
+    return true;
+}
+
+// Synthetic tracing: a closed path found by casting rays from the image centre to the outline,
+// followed with a little seeded jitter, one mouse sample per tick and the stroke between samples
+// scratched as in the game
+static BenchResult BenchDalgonaTrace(const char *file, const OutlineField &field, int ticks, uint64_t seed) {
+    BenchResult r = {std::string("dalgona_trace_") + GetFileNameWithoutExt(file), "tick"};
+    std::vector<Vector2> path;
+    const int rays = 720;
+    float cx = field.width / 2.0f, cy = field.height / 2.0f;
+    for (int i = 0; i < rays; i++) {
+        float a = i * 2.0f * PI / rays;
+        for (float d = 0; ; d += 1.0f) {
+            int x = (int)(cx + cosf(a) * d), y = (int)(cy + sinf(a) * d);
+            if (!field.InBounds(x, y)) break;
+            if (field.IsOutline(x, y)) {
+                path.push_back({(float)x, (float)y});
+                break;
+            }
+        }
+    }
+    if (path.empty()) return r;
+
+    Pcg32 rng(seed, STREAM_DALGONA);
+    TiledBitset scratched(field.width, field.height);
+    OpTimer timer;
+    timer.Reserve(ticks);
+    r.checksum = 1469598103934665603ULL;
+    int lastX = (int)path[0].x, lastY = (int)path[0].y;
+    for (int t = 0; t < ticks; t++) {
+        if (t % (int)path.size() == 0) {
+            MixHash(r.checksum, (unsigned long long)scratched.count);
+            scratched.Clear();
+        }
+        const Vector2 &p = path[t % path.size()];
+        int x = (int)p.x + (int)rng.Range(7) - 3;
+        int y = (int)p.y + (int)rng.Range(7) - 3;
+        timer.Run([&] { ScratchOutlineAlong(field, lastX, lastY, x, y, DALGONA_SCRATCH_RADIUS, scratched); });
+        lastX = x;
+        lastY = y;
+    }
+    MixHash(r.checksum, (unsigned long long)scratched.count);
+    timer.Finish(r);
+    return r;
+}
+
+// Vector cookie: flatten, index and render the texture (what dealing a shape costs in the hub)
+static BenchResult BenchCookieBuild(const CookieShape &shape, int repeats, CookieOutline &outline) {
+    BenchResult r = {std::string("cookie_build_") + shape.name, "build"};
+    OpTimer timer;
+    for (int i = 0; i < repeats; i++)
+        timer.Run([&] {
+            outline = BuildCookieOutline(shape.make(), COOKIE_BENCH_SIZE);
+            Image img = GenCookieImage(outline);
+            UnloadImage(img);
+        });
+    timer.Finish(r);
+    r.checksum = (unsigned long long)outline.beads;
+    return r;
+}
+
+// Synthetic tracing of a vector cookie: points about 8 pixels apart along the outline with seeded
+// jitter, one mouse sample per tick, the stroke between samples scratched as in the hub
+static BenchResult BenchCookieTrace(const CookieShape &shape, const CookieOutline &outline, int ticks, uint64_t seed) {
+    BenchResult r = {std::string("cookie_trace_") + shape.name, "tick"};
+    std::vector<Vector2> path;
+    for (size_t s = 0; s < outline.from.size(); s++) {
+        float len = outline.along[s + 1] - outline.along[s];
+        int steps = std::max(1, (int)(len / 8.0f));
+        for (int i = 0; i < steps; i++) path.push_back(PathLerp(outline.from[s], outline.to[s], (float)i / steps));
+    }
+    if (path.empty()) return r;
+
+    Pcg32 rng(seed, STREAM_DALGONA);
+    CookieScratch scratched(outline.beads);
+    OpTimer timer;
+    timer.Reserve(ticks);
+    r.checksum = 1469598103934665603ULL;
+    int lastX = (int)path[0].x, lastY = (int)path[0].y;
+    for (int t = 0; t < ticks; t++) {
+        if (t % (int)path.size() == 0) {
+            MixHash(r.checksum, (unsigned long long)scratched.count);
+            scratched.Clear();
+        }
+        const Vector2 &p = path[t % path.size()];
+        int x = (int)p.x + (int)rng.Range(7) - 3;
+        int y = (int)p.y + (int)rng.Range(7) - 3;
+        timer.Run([&] { ScratchCookieAlong(outline, lastX, lastY, x, y, DALGONA_SCRATCH_RADIUS, scratched); });
+        scratched.fresh.clear();
+        lastX = x;
+        lastY = y;
+    }
+    MixHash(r.checksum, (unsigned long long)scratched.count);
+    timer.Finish(r);
+    return r;
+}
+
+// One op is a block of 4096 groups of 16 crossing the show's 18-row bridge
+static BenchResult BenchBridgeBatch(int blocks, uint64_t seed) {
+    BenchResult r = {"bridge_batch", "block"};
+    BridgeBatchConfig cfg;
+    cfg.rows = 18;
+    cfg.rule = BRIDGE_ONE_SAFE;
+    cfg.groups = 64LL * BRIDGE_BATCH_WORDS;
+    BridgeBatchStats stats;
+    stats.crossed.assign(cfg.groupSize, 0);
+    stats.rowDeaths.assign(cfg.rows, 0);
+
+    OpTimer timer;
+    timer.Reserve(blocks);
+    for (int b = 0; b < blocks; b++) {
+        Pcg32 rng(seed, ((uint64_t)STREAM_BRIDGE << 40) + (uint64_t)b);
+        timer.Run([&] { SimulateBridgeBlock(cfg, 0, rng, stats); });
+    }
+    timer.Finish(r);
+    r.checksum = 1469598103934665603ULL;
+    for (long long c : stats.crossed) MixHash(r.checksum, (unsigned long long)c);
+    return r;
+}
+
+// Drives a scene's Update with scripted input; press(tick, rng) returns the tick's input
+template <typename Press>
+static BenchResult BenchScene(const char *name, Scene &scene, int ticks, uint64_t seed, Press press) {
+    BenchResult r = {name, "tick"};
+    SceneContext ctx;
+    ctx.width = 1000;
+    ctx.height = 700;
+    ctx.seed = seed;
+    if (!scene.Init(ctx)) return r;
+    scene.Enter();
+
+    Pcg32 rng(seed, 0x5eed);
+    std::vector<InputFrame> inputs(ticks);
+    for (int t = 0; t < ticks; t++) inputs[t] = press(t, rng);
+    OpTimer timer;
+    timer.Reserve(ticks);
+    for (int t = 0; t < ticks; t++) timer.Run([&] { scene.Update(inputs[t]); });
+    timer.Finish(r);
+    scene.Shutdown();
+    return r; // scene state is private, so there is no outcome checksum
+}
+
+static InputFrame Click(float x, float y) {
+    InputFrame in;
+    in.mouseX = (int16_t)x;
+    in.mouseY = (int16_t)y;
+    in.mouseDown = in.mousePressed = 1;
+    return in;
+}
+
+// ---------------------------
+// Reports
+// ---------------------------
+
+static void WriteReport(FILE *f, uint64_t seed, const std::vector<BenchResult> &results) {
+    fprintf(f, "{\"version\":%d,\"seed\":%llu,\"scenarios\":[\n", BENCH_REPORT_VERSION, (unsigned long long)seed);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        fprintf(f, "{\"name\":\"%s\",\"unit\":\"%s\",\"ops\":%lld,\"seconds\":%.6f,\"ops_per_sec\":%.1f,"
+                   "\"p50_us\":%.3f,\"p90_us\":%.3f,\"p99_us\":%.3f,\"max_us\":%.3f,\"checksum\":\"%016llx\"}%s\n",
+                r.name.c_str(), r.unit, r.ops, r.seconds, r.OpsPerSec(), r.p50, r.p90, r.p99, r.max, r.checksum,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "]}\n");
+}
+
+static double JsonNumber(const char *line, const char *key) {
+    const char *p = strstr(line, key);
+    return p ? atof(p + strlen(key)) : 0.0;
+}
+
+// Reads the one-scenario-per-line reports WriteReport produces
+static bool ReadReport(const char *path, std::vector<BenchResult> &out) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        const char *name = strstr(line, "\"name\":\"");
+        if (!name) continue;
+        name += 8;
+        const char *end = strchr(name, '"');
+        if (!end) continue;
+        BenchResult r = {std::string(name, end), ""};
+        r.ops = (long long)JsonNumber(line, "\"ops\":");
+        r.seconds = JsonNumber(line, "\"seconds\":");
+        r.p99 = JsonNumber(line, "\"p99_us\":");
+        const char *sum = strstr(line, "\"checksum\":\"");
+        if (sum) r.checksum = strtoull(sum + 12, nullptr, 16);
+        out.push_back(r);
+    }
+    fclose(f);
+    return true;
+}
+
+// Returns the number of regressions
+static int CompareToBaseline(const std::vector<BenchResult> &results, const std::vector<BenchResult> &baseline,
+                             double maxSlowdown, double maxP99Growth) {
+    int regressions = 0;
+    fprintf(stderr, "\n%-28s %14s %14s %8s %10s %10s\n", "scenario", "baseline op/s", "op/s", "change", "base p99", "p99");
+    for (const BenchResult &r : results) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult &b) { return b.name == r.name; });
+        if (it == baseline.end()) {
+            fprintf(stderr, "%-28s %14s %14.0f   (new)\n", r.name.c_str(), "-", r.OpsPerSec());
+            continue;
+        }
+        double change = it->OpsPerSec() > 0 ? r.OpsPerSec() / it->OpsPerSec() - 1.0 : 0.0;
+        bool slower = change < -maxSlowdown;
+        bool spikier = it->p99 > 0 && r.p99 - it->p99 > std::max(P99_NOISE_FLOOR_US, it->p99 * maxP99Growth);
+        fprintf(stderr, "%-28s %14.0f %14.0f %+7.1f%% %10.2f %10.2f%s%s%s\n", r.name.c_str(), it->OpsPerSec(),
+                r.OpsPerSec(), change * 100.0, it->p99, r.p99, slower ? "  SLOWER" : "", spikier ? "  P99" : "",
+                it->checksum != r.checksum ? "  (different outcome)" : "");
+        if (slower || spikier) regressions++;
+    }
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    uint64_t seed = 456;
+    bool quick = false;
+    const char *baselinePath = nullptr;
+    const char *outPath = nullptr;
+    const char *only = nullptr;
+    double maxSlowdown = 0.10;
+    double maxP99Growth = 0.25;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--seed") && hasValue) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--quick")) quick = true;
+        else if (!strcmp(argv[i], "--baseline") && hasValue) baselinePath = argv[++i];
+        else if (!strcmp(argv[i], "--out") && hasValue) outPath = argv[++i];
+        else if (!strcmp(argv[i], "--only") && hasValue) only = argv[++i];
+        else if (!strcmp(argv[i], "--max-slowdown") && hasValue) maxSlowdown = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--max-p99-growth") && hasValue) maxP99Growth = atof(argv[++i]);
+        else {
+            printf("Usage: %s [--seed S] [--quick] [--only SUBSTRING] [--out FILE]\n"
+                   "          [--baseline FILE] [--max-slowdown FRACTION] [--max-p99-growth FRACTION]\n"
+                   "  Writes a JSON report to stdout (or --out FILE). With --baseline, exits with status 2\n"
+                   "  when a scenario's throughput drops by more than --max-slowdown (default 0.10) or its\n"
+                   "  p99 latency grows by more than --max-p99-growth (default 0.25).\n", argv[0]);
+            return 1;
+        }
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    auto wanted = [&](const std::string &name) { return !only || name.find(only) != std::string::npos; };
+    const int scale = quick ? 10 : 1;
+    std::vector<BenchResult> results;
+    auto add = [&](BenchResult r) {
+        if (r.ops == 0) return;
+        fprintf(stderr, "%-28s %10lld %-5s %12.0f op/s  p50 %8.2f  p99 %8.2f us\n", r.name.c_str(), r.ops, r.unit,
+                r.OpsPerSec(), r.p50, r.p99);
+        results.push_back(r);
+    };
+
+    for (int players : {4, 1000, 10000}) {
+        if (wanted("redlight_" + std::to_string(players))) add(BenchRedLight(players, quick ? 1 : 5, seed));
+    }
+
+    for (const char *file : DALGONA_SHAPES) {
+        std::string stem = GetFileNameWithoutExt(file);
+        if (!wanted("dalgona_outline_" + stem) && !wanted("dalgona_trace_" + stem)) continue;
+        BenchResult build;
+        OutlineField field;
+        if (!BenchDalgonaOutline(file, quick ? 3 : 20, build, field)) {
+            fprintf(stderr, "%-28s skipped: cannot load %s\n", ("dalgona_*_" + stem).c_str(), file);
+            continue;
+        }
+        if (wanted(build.name)) add(build);
+        if (wanted("dalgona_trace_" + stem)) add(BenchDalgonaTrace(file, field, 200000 / scale, seed));
+    }
+
+    for (const CookieShape &shape : COOKIE_SHAPES) {
+        std::string name = shape.name;
+        if (!wanted("cookie_build_" + name) && !wanted("cookie_trace_" + name)) continue;
+        CookieOutline outline;
+        BenchResult build = BenchCookieBuild(shape, quick ? 3 : 20, outline);
+        if (wanted(build.name)) add(build);
+        if (wanted("cookie_trace_" + name)) add(BenchCookieTrace(shape, outline, 200000 / scale, seed));
+    }
+
+    if (wanted("bridge_rounds")) {
+        BridgeScene bridge;
+        // Pick a side and step every tick; R restarts once the round is over
+        add(BenchScene("bridge_rounds", bridge, 500000 / scale, seed, [](int, Pcg32 &rng) {
+            InputFrame in;
+            in.keysPressed = (1u << (rng.Range(2) ? BridgeScene::IN_RIGHT : BridgeScene::IN_LEFT)) |
+                             (1u << BridgeScene::IN_SPACE) | (1u << BridgeScene::IN_RESTART);
+            return in;
+        }));
+    }
+
+    if (wanted("bridge_batch")) add(BenchBridgeBatch(20000 / scale, seed));
+
+    if (wanted("marble_rounds")) {
+        MarbleScene marble;
+        // Every tenth tick click a guess or bet button at random, so rounds play out against the AI
+        add(BenchScene("marble_rounds", marble, 500000 / scale, seed, [](int t, Pcg32 &rng) {
+            InputFrame in;
+            if (t % 10 == 0) {
+                uint32_t choice = rng.Range(4);
+                int bet = (int)rng.Range(MarbleScene::maxBet);
+                if (choice == 0) in = Click(180, 470);                      // Guess Odd
+                else if (choice == 1) in = Click(380, 470);                 // Guess Even
+                else in = Click(140 + bet * 90.0f, choice == 2 ? 555 : 485); // bet / put buttons
+            }
+            in.keysPressed |= 1u << MarbleScene::IN_RESTART;
+            return in;
+        }));
+    }
+
+    if (wanted("rope_pulls")) {
+        RopeScene rope;
+        // Both players mash at random; R restarts once someone wins
+        add(BenchScene("rope_pulls", rope, 500000 / scale, seed, [](int, Pcg32 &rng) {
+            InputFrame in;
+            if (rng.Chance(0.5f)) in.keysPressed |= 1u << RopeScene::IN_PULL_P1;
+            if (rng.Chance(0.5f)) in.keysPressed |= 1u << RopeScene::IN_PULL_P2;
+            in.keysPressed |= 1u << RopeScene::IN_RESTART;
+            return in;
+        }));
+    }
+
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", outPath);
+        return 1;
+    }
+    WriteReport(out, seed, results);
+    if (outPath) fclose(out);
+
+    if (baselinePath) {
+        std::vector<BenchResult> baseline;
+        if (!ReadReport(baselinePath, baseline)) {
+            fprintf(stderr, "Cannot read baseline %s\n", baselinePath);
+            return 1;
+        }
+        int regressions = CompareToBaseline(results, baseline, maxSlowdown, maxP99Growth);
+        if (regressions > 0) {
+            fprintf(stderr, "%d scenario(s) regressed\n", regressions);
+            return 2;
+        }
+        fprintf(stderr, "No regressions against %s\n", baselinePath);
+    }
+    return 0;
+}
@@ -7,6 +7,26 @@
 #include <ctime>
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include "cookie_shapes.h"
+#include "scratch_overlay.h"
+#include "redlight_sim.h"
+#include "sim_clock.h"
+#include "sim_random.h"
+#include "game_input.h"
+#include "replay.h"
+#include "scene.h"
+#include "bridge_scene.h"
+#include "marble_scene.h"
+#include "rope_scene.h"
+#include "asset_cache.h"
+#include "sprite_atlas.h"
+#include "crowd_renderer.h"
+#include "frame_profiler.h"
+#include "frame_pacer.h"
+#include "outlined_text.h"
+#include "ui_screen.h"
+#include "tournament_results.h"
 
 struct Player {
     std::string name;
@@ -24,28 +44,70 @@ struct Player {
 const int SCREEN_WIDTH = 1280;
 const int SCREEN_HEIGHT = 720;
 
-enum GameState { MENU, CONTROLS, REDLIGHT, DALGONA, WINNERS, GAMEOVER };
+enum GameState { MENU, CONTROLS, REDLIGHT, DALGONA, ROPE, BRIDGE, MARBLE, WINNERS, GAMEOVER };
 GameState currentState = MENU;
 
-enum Phase { PHASE_GREEN, PHASE_RED };
-
 Font gameFont;
+OutlinedText outlinedText; // glyph atlas behind DrawTextOutlined
 Sound hitSound, winSound, dollPoem;
-Texture2D dollFront, dollBack;
-std::vector<Texture2D> playerTextures;
+Sprite dollFront, dollBack;
+std::vector<Sprite> playerSprites;
+Sprite playerGlow;
+SpriteBatch sprites; // atlas sprites for the current frame, flushed before text goes on top
+const char *PLAYER_GLOW_SPRITE = "player glow"; // generated disc in the atlas, tinted per player
+const int PLAYER_GLOW_RADIUS = 38;
+
+// --crowd N: bot contestants below the four players, drawn culled and by level of detail
+int crowdSize = 0;
+CrowdRenderer crowd;
+const char *CROWD_DOT_SPRITE = "crowd dot"; // generated white square in the atlas, tinted per lane
 
 std::vector<Player> players;
 
-float gameTimer = 30.0f;
-Phase currentPhase = PHASE_GREEN;
-float phaseTimer = 0.0f;
 float greenDuration = 0.0f;
 float redDuration = 2.0f;
 
-// Dalgona resources
-Texture2D dalgonaShapes[4];
+// Dalgona resources (the cookies themselves are generated from COOKIE_SHAPES, see cookie_shapes.h)
+Sprite cookieBox; // closed box image for selection
 Sound crackSound, scratchSound;
 
+// Every file the hub uses is decoded in the background from startup; each mini-game acquires
+// its assets on entry and releases them on exit, and they stay cached in between.
+// assets.sqb (see asset_packer.cpp), when present, replaces the decoding.
+AssetBundle bundle;
+AssetCache assets;
+const char *PLAYER_TEXTURE_FILES[4] = {"456.png", "222.png", "333.png", "388.png"};
+// Every image the hub and its scenes draw, packed into one atlas texture as soon as it is decoded
+const std::vector<std::string> ATLAS_FILES = {"doll_front.png", "doll_back.png", "456.png", "222.png", "333.png",
+                                              "388.png", "cookie_box.png", "rope.png"};
+const char *PRELOAD_SOUNDS[] = {"hit.mp3", "win.mp3", "poem.mp3", "crack.mp3", "scratch.mp3", "glass_break.mp3"};
+
+// Seeded per-game random streams (see sim_random.h)
+uint64_t runSeed = 0;
+Pcg32 dalgonaRng;
+
+// --record / --replay / --fast (see replay.h)
+ReplaySession replay;
+
+// Mini-games that also build as standalone programs; they share this window, the audio
+// device and the contestant textures
+RopeScene ropeScene;
+BridgeScene bridgeScene;
+MarbleScene marbleScene;
+SceneContext sceneCtx;
+
+// Scenes load their assets the first time they are entered
+enum SceneStatus { SCENE_UNLOADED, SCENE_READY, SCENE_FAILED };
+SceneStatus ropeStatus = SCENE_UNLOADED, bridgeStatus = SCENE_UNLOADED, marbleStatus = SCENE_UNLOADED;
+
+// Standings across every round played here or in the standalone games (--results FILE)
+TournamentResults tournament;
+
+// Same rule as the hosted scenes: nothing is recorded unless the log was opened
+void RecordResult(ReplayGame game, const char *name, ResultOutcome outcome, float time = -1.0f) {
+    if (sceneCtx.results) sceneCtx.results->Record(game, name, outcome, time);
+}
+
 void ResetPlayers() {
     int startX = 80;
     int startY = 200;
@@ -59,22 +121,13 @@ void ResetPlayers() {
     }
 }
 
-bool AreAllPlayersDeadOrFinished() {
-    for (auto &p : players) if (p.alive && !p.finished) return false;
-    return true;
-}
-
 void DrawTextOutlined(const char *text, int x, int y, int fontSize, Color textColor, Color outlineColor) {
-    for (int ox = -2; ox <= 2; ox++) {
-        for (int oy = -2; oy <= 2; oy++) {
-            if (ox == 0 && oy == 0) continue;
-            DrawText(text, x + ox, y + oy, fontSize, outlineColor);
-        }
-    }
-    DrawText(text, x, y, fontSize, textColor);
+    PROFILE_COUNT("outlined labels", 1);
+    outlinedText.Draw(text, x, y, fontSize, textColor, outlineColor);
 }
 
-void DrawPlayer(const Player &p) {
+// Glow and portrait go into the sprite batch; the name is drawn once the batch is flushed
+void DrawPlayer(const Player &p, SpriteBatch &batch) {
     if (!p.alive) return;
 
     float glow = (sinf(p.glowPhase) + 1.0f) / 2.0f;
@@ -83,18 +136,15 @@ void DrawPlayer(const Player &p) {
         (unsigned char)(p.color.g + (255 - p.color.g) * glow),
         (unsigned char)(p.color.b + (255 - p.color.b) * glow),
         200};
-    DrawCircleV(p.pos, 38, glowColor); // Glow behind
-
-    Texture2D tex = playerTextures[p.textureIndex];
+    batch.DrawCentered(playerGlow, p.pos, 1.0f, glowColor); // Glow behind
 
     // Special scale for player 456 (index 0) to visually match others
     float scale = (p.textureIndex == 0) ? 0.38f : 0.5f;
+    batch.DrawCentered(playerSprites[p.textureIndex], p.pos, scale, WHITE);
+}
 
-    float width = tex.width * scale;
-    float height = tex.height * scale;
-    Vector2 drawPos = { p.pos.x - width / 2, p.pos.y - height / 2 };
-    DrawTextureEx(tex, drawPos, 0.0f, scale, WHITE);
-
+void DrawPlayerName(const Player &p) {
+    if (!p.alive) return;
     DrawTextEx(gameFont, p.name.c_str(), {(float)p.pos.x - 28, (float)p.pos.y - 50}, 24, 1, WHITE);
 }
 
@@ -107,20 +157,112 @@ void DrawBackground() {
         DrawLine(0, y, SCREEN_WIDTH, y, (Color){255, 105, 180, 80});
 }
 
-#include <cstdlib>  // for std::system
+// ---------------------------
+// Static screens (retained: rendered once into a texture, repainted only where a label changes)
+// ---------------------------
+UiScreen menuScreen, controlsScreen, winnersScreen;
+int winnerSlots[4]; // winnersScreen labels, one per possible finisher
+const int STANDINGS_SHOWN = 8;
+int standingSlots[STANDINGS_SHOWN]; // winnersScreen labels for the tournament's leaders
+uint64_t shownStandingsVersion = ~0ULL;
+
+struct PlayerResult {
+    bool ranked;
+    float finishTime;
+    bool operator==(const PlayerResult &o) const { return ranked == o.ranked && finishTime == o.finishTime; }
+};
+std::vector<PlayerResult> shownResults; // what winnersScreen currently shows
+
+void LoadScreens() {
+    menuScreen.Load(SCREEN_WIDTH, SCREEN_HEIGHT, DrawBackground, DrawTextOutlined);
+    menuScreen.AddLabel("Super Squid Tournament", SCREEN_WIDTH / 2 - 300, 100, 60, DARKPURPLE);
+    menuScreen.AddLabel("1) Start Game - Red Light, Green Light", SCREEN_WIDTH / 2 - 300, 300, 30, WHITE);
+    menuScreen.AddLabel("2) Tug of War", SCREEN_WIDTH / 2 - 300, 350, 30, WHITE);
+    menuScreen.AddLabel("3) Dalgona Candy (Mini-Game)", SCREEN_WIDTH / 2 - 300, 400, 30, WHITE);
+    menuScreen.AddLabel("4) Bridge game", SCREEN_WIDTH / 2 - 300, 450, 30, WHITE);
+    menuScreen.AddLabel("5) Marble", SCREEN_WIDTH / 2 - 300, 500, 30, WHITE);
+    menuScreen.AddLabel("6) Controls", SCREEN_WIDTH / 2 - 300, 550, 30, WHITE);
+    menuScreen.AddLabel("Q) Quit", SCREEN_WIDTH / 2 - 300, 600, 30, WHITE);
+
+    controlsScreen.Load(SCREEN_WIDTH, SCREEN_HEIGHT, DrawBackground, DrawTextOutlined);
+    controlsScreen.AddLabel("Controls", SCREEN_WIDTH / 2 - 60, 100, 50, WHITE);
+    controlsScreen.AddLabel("Blue (456): → key", 200, 200, 30, BLUE);
+    controlsScreen.AddLabel("Red (222): D key", 200, 250, 30, RED);
+    controlsScreen.AddLabel("Green (333): E key", 200, 300, 30, GREEN);
+    controlsScreen.AddLabel("Yellow (388): S key", 200, 350, 30, GOLD);
+    controlsScreen.AddLabel("Press B to go back", SCREEN_WIDTH / 2 - 100, 600, 30, WHITE);
+
+    winnersScreen.Load(SCREEN_WIDTH, SCREEN_HEIGHT, DrawBackground, DrawTextOutlined);
+    winnersScreen.AddLabel("Winners", SCREEN_WIDTH / 2 - 80, 50, 50, WHITE);
+    for (int i = 0; i < 4; i++) winnerSlots[i] = winnersScreen.AddLabel("", 400, 150 + i * 50, 40, WHITE);
+    winnersScreen.AddLabel("Tournament", 760, 110, 30, GOLD);
+    for (int i = 0; i < STANDINGS_SHOWN; i++) standingSlots[i] = winnersScreen.AddLabel("", 760, 150 + i * 40, 26, WHITE);
+    winnersScreen.AddLabel("Press M to go to Menu", SCREEN_WIDTH / 2 - 150, 600, 30, WHITE);
+}
+
+void UnloadScreens() {
+    menuScreen.Unload();
+    controlsScreen.Unload();
+    winnersScreen.Unload();
+}
+
+// The standings are kept in order by the store; relabel only when a result came in
+void UpdateStandings() {
+    if (tournament.Version() == shownStandingsVersion) return;
+    shownStandingsVersion = tournament.Version();
+
+    std::vector<const Standing *> top = tournament.Top(STANDINGS_SHOWN);
+    for (int i = 0; i < STANDINGS_SHOWN; i++) {
+        if (i >= (int)top.size()) {
+            winnersScreen.SetLabel(standingSlots[i], "", WHITE);
+            continue;
+        }
+        const Standing &s = *top[i];
+        Color color = WHITE;
+        for (const Player &p : players)
+            if (p.name == s.name) color = p.color;
+        std::string line = TextFormat("%d) %s  %dW %dL", i + 1, s.name.c_str(), s.wins, s.losses);
+        if (s.bestTime >= 0) line += TextFormat("  %.1fs", s.bestTime);
+        winnersScreen.SetLabel(standingSlots[i], line, color);
+    }
+}
+
+// Re-rank only when a result changed since the screen was last updated
+void UpdateWinnersScreen() {
+    UpdateStandings();
+    std::vector<PlayerResult> results;
+    for (const Player &p : players) results.push_back({p.finished && p.alive, p.finishTime});
+    if (results == shownResults) return;
+    shownResults = results;
+
+    std::vector<const Player *> ranked;
+    for (const Player &p : players)
+        if (p.finished && p.alive) ranked.push_back(&p);
+    std::stable_sort(ranked.begin(), ranked.end(), [](const Player *a, const Player *b) {
+        if (a->finishTime < 0 || b->finishTime < 0) return b->finishTime < 0 && a->finishTime >= 0;
+        return a->finishTime < b->finishTime;
+    });
+    for (int i = 0; i < 4; i++) {
+        if (i < (int)ranked.size())
+            winnersScreen.SetLabel(winnerSlots[i], TextFormat("%d) %s", i + 1, ranked[i]->name.c_str()), ranked[i]->color);
+        else
+            winnersScreen.SetLabel(winnerSlots[i], "", WHITE);
+    }
+}
+
+// Static screens sleep until input once the background asset loads are done (Poll needs
+// frames to upload them); a replay never waits for input it doesn't get from the window
+double StaticScreenIdle() {
+    return replay.Replaying() || !assets.Idle() ? 0.0 : IDLE_UNTIL_INPUT;
+}
 
 void ShowMenu() {
     BeginDrawing();
-    DrawBackground();
-    DrawTextOutlined("Super Squid Tournament", SCREEN_WIDTH / 2 - 300, 100, 60, DARKPURPLE, BLACK);
-
-    DrawTextOutlined("1) Start Game - Red Light, Green Light", SCREEN_WIDTH / 2 - 300, 300, 30, WHITE, BLACK);
-    DrawTextOutlined("2) Tug of War", SCREEN_WIDTH / 2 - 300, 350, 30, WHITE, BLACK);
-    DrawTextOutlined("3) Dalgona Candy (Mini-Game)", SCREEN_WIDTH / 2 - 300, 400, 30, WHITE, BLACK);
-    DrawTextOutlined("4) Bridge game", SCREEN_WIDTH / 2 - 300, 450, 30, WHITE, BLACK);
-    DrawTextOutlined("5) Marble", SCREEN_WIDTH / 2 - 300, 500, 30, WHITE, BLACK);
-    DrawTextOutlined("6) Controls", SCREEN_WIDTH / 2 - 300, 550, 30, WHITE, BLACK);
-    DrawTextOutlined("Q) Quit", SCREEN_WIDTH / 2 - 300, 600, 30, WHITE, BLACK);
+    PROFILE_BEGIN("draw");
+    menuScreen.Draw();
+    PROFILE_END();
+    PROFILE_FRAME();
+    Pacer().Idle(StaticScreenIdle());
     EndDrawing();
 
     if (IsKeyPressed(KEY_ONE)) {
@@ -128,20 +270,20 @@ void ShowMenu() {
         currentState = REDLIGHT;
     }
     else if (IsKeyPressed(KEY_TWO)) {
-        printf("Pressed 2 - Launching rope.exe\n");
-        std::system("./rope");  // Update path if needed
+        printf("Pressed 2 - Starting Tug of War\n");
+        currentState = ROPE;
     }
     else if (IsKeyPressed(KEY_THREE)) {
         printf("Pressed 3 - Starting Dalgona\n");
         currentState = DALGONA;
     }
     else if (IsKeyPressed(KEY_FOUR)) {
-        printf("Pressed 4 - Launching bridge.exe\n");
-        std::system("./bridge");  // Update path if needed
+        printf("Pressed 4 - Starting Glass Bridge\n");
+        currentState = BRIDGE;
     }
     else if (IsKeyPressed(KEY_FIVE)) {
-        printf("Pressed 5 - Launching marble.exe\n");
-        std::system("./marble");  // Update path if needed
+        printf("Pressed 5 - Starting Marbles\n");
+        currentState = MARBLE;
     }
     else if (IsKeyPressed(KEY_SIX)) {
         printf("Pressed 6 - Showing Controls\n");
@@ -156,13 +298,11 @@ void ShowMenu() {
 
 void ShowControls() {
     BeginDrawing();
-    DrawBackground();
-    DrawTextOutlined("Controls", SCREEN_WIDTH / 2 - 60, 100, 50, WHITE, BLACK);
-    DrawTextOutlined("Blue (456): → key", 200, 200, 30, BLUE, BLACK);
-    DrawTextOutlined("Red (222): D key", 200, 250, 30, RED, BLACK);
-    DrawTextOutlined("Green (333): E key", 200, 300, 30, GREEN, BLACK);
-    DrawTextOutlined("Yellow (388): S key", 200, 350, 30, GOLD, BLACK);
-    DrawTextOutlined("Press B to go back", SCREEN_WIDTH / 2 - 100, 600, 30, WHITE, BLACK);
+    PROFILE_BEGIN("draw");
+    controlsScreen.Draw();
+    PROFILE_END();
+    PROFILE_FRAME();
+    Pacer().Idle(StaticScreenIdle());
     EndDrawing();
 
     if (IsKeyPressed(KEY_B)) currentState = MENU;
@@ -170,182 +310,269 @@ void ShowControls() {
 }
 
 void ShowWinners() {
+    UpdateWinnersScreen();
     BeginDrawing();
-    DrawBackground();
-    DrawTextOutlined("Winners", SCREEN_WIDTH / 2 - 80, 50, 50, WHITE, BLACK);
-
-    std::vector<Player> sortedPlayers = players;
-    std::sort(sortedPlayers.begin(), sortedPlayers.end(),
-              [](const Player &a, const Player &b) {
-                  if (a.finishTime < 0 && b.finishTime < 0) return false;
-                  if (a.finishTime < 0) return false;
-                  if (b.finishTime < 0) return true;
-                  return a.finishTime < b.finishTime;
-              });
-
-    int y = 150;
-    int rank = 1;
-    for (auto &p : sortedPlayers) {
-        if (p.finished && p.alive) {
-            DrawTextOutlined(TextFormat("%d) %s", rank, p.name.c_str()), 400, y, 40, p.color, BLACK);
-            y += 50;
-            rank++;
+    PROFILE_BEGIN("draw");
+    winnersScreen.Draw();
+    PROFILE_END();
+    PROFILE_FRAME();
+    Pacer().Idle(StaticScreenIdle());
+    EndDrawing();
+
+    if (IsKeyPressed(KEY_M)) currentState = MENU;
+}
+
+// Keyboard input: every contestant holds their own move key (binding i = players[i].moveKey).
+// The crowd behind them, if any, is played by bots.
+class KeyboardInput : public RedLightInput {
+public:
+    InputFrame frame; // latched input for the coming tick
+    std::unique_ptr<BotInput> crowd;
+
+    void Sample(const RedLightState &state, const PlayerField &field, std::vector<uint64_t> &wantsMove) override {
+        if (crowd) crowd->Sample(state, field, wantsMove);
+        else std::fill(wantsMove.begin(), wantsMove.end(), 0);
+        for (size_t i = 0; i < players.size(); i++) {
+            wantsMove[i / 64] &= ~(1ULL << (i % 64));
+            if (frame.Down((int)i)) wantsMove[i / 64] |= 1ULL << (i % 64);
         }
     }
+};
 
-    DrawTextOutlined("Press M to go to Menu", SCREEN_WIDTH / 2 - 150, 600, 30, WHITE, BLACK);
-    EndDrawing();
+// Mouse wheel zooms about the cursor, right drag pans, Home resets. The camera only changes
+// what is drawn, so it isn't part of the recorded input.
+void UpdateFieldCamera(Camera2D &camera) {
+    if (IsKeyPressed(KEY_HOME)) camera = {{0, 0}, {0, 0}, 0.0f, 1.0f};
+    if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+        Vector2 delta = GetMouseDelta();
+        camera.target.x -= delta.x / camera.zoom;
+        camera.target.y -= delta.y / camera.zoom;
+    }
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) {
+        Vector2 mouse = GetMousePosition();
+        camera.target = GetScreenToWorld2D(mouse, camera);
+        camera.offset = mouse;
+        camera.zoom = std::clamp(camera.zoom * powf(1.2f, wheel), 0.02f, 4.0f);
+    }
+}
 
-    if (IsKeyPressed(KEY_M)) currentState = MENU;
+void AcquireRedLightAssets() {
+    hitSound = assets.AcquireSound("hit.mp3");
+    winSound = assets.AcquireSound("win.mp3");
+    dollPoem = assets.AcquireSound("poem.mp3");
+    dollFront = assets.AcquireSprite("doll_front.png");
+    dollBack = assets.AcquireSprite("doll_back.png");
+    playerSprites.clear();
+    for (const char *file : PLAYER_TEXTURE_FILES) playerSprites.push_back(assets.AcquireSprite(file));
+    playerGlow = assets.AcquireSprite(PLAYER_GLOW_SPRITE);
+    if (crowdSize > 0) {
+        crowd.portraits = playerSprites;
+        crowd.glow = playerGlow;
+        crowd.dot = assets.AcquireSprite(CROWD_DOT_SPRITE);
+        crowd.Load(gameFont);
+    }
+
+    // Green light lasts as long as the poem
+    greenDuration = dollPoem.stream.sampleRate ? (float)dollPoem.frameCount / dollPoem.stream.sampleRate : 4.0f;
 }
 
-void RedLightGreenLight() {
+void ReleaseRedLightAssets() {
+    for (const char *file : {"hit.mp3", "win.mp3", "poem.mp3", "doll_front.png", "doll_back.png"}) assets.Release(file);
+    for (const char *file : PLAYER_TEXTURE_FILES) assets.Release(file);
+    assets.Release(PLAYER_GLOW_SPRITE);
+    if (crowdSize > 0) assets.Release(CROWD_DOT_SPRITE);
+    crowd.Unload();
+}
+
+void RunRedLightGreenLight() {
     ResetPlayers();
-    const int finishX = SCREEN_WIDTH - 150;
-    gameTimer = 30.0f;
-    currentPhase = PHASE_GREEN;
-    phaseTimer = 0.0f;
+    RedLightRules rules;
+    rules.greenDuration = greenDuration;
+    rules.redDuration = redDuration;
+    rules.finishX = SCREEN_WIDTH - 150;
+
+    RedLightState state;
+    PlayerField field;
+    field.Resize(players.size() + crowdSize);
+    StartRedLight(state, rules, field, players[0].pos.x);
+    std::vector<float> prevX = field.x; // positions at the previous tick, for interpolation
+    CrowdLayout crowdLayout;
+    crowdLayout.first = players.size();
+    crowdLayout.count = crowdSize;
+    crowdLayout.startY = players.back().pos.y + 100;
+    crowdLayout.firstNumber = 457; // after the show's 456, so no bot shares a player's number
+    Camera2D camera = {{0, 0}, {0, 0}, 0.0f, 1.0f};
+
+    std::vector<int> moveKeys;
+    for (auto &p : players) moveKeys.push_back(p.moveKey);
+    InputLatch latch(moveKeys);
+    KeyboardInput input;
+    if (crowdSize > 0) input.crowd = std::make_unique<BotInput>(field.count, runSeed);
+    FixedStepClock clock;
+    std::vector<uint64_t> wantsMove(field.words, 0);
+    std::vector<RedLightEvent> events;
+    bool roundOver = false;
     PlaySound(dollPoem);
+    replay.BeginSegment(REPLAY_REDLIGHT);
 
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        gameTimer -= dt;
-        phaseTimer += dt;
-
-        if (currentPhase == PHASE_GREEN && phaseTimer >= greenDuration) {
-            currentPhase = PHASE_RED;
-            phaseTimer = 0;
-        } else if (currentPhase == PHASE_RED && phaseTimer >= redDuration) {
-            currentPhase = PHASE_GREEN;
-            phaseTimer = 0;
-            PlaySound(dollPoem);
+        PROFILE_BEGIN("input");
+        latch.Poll();
+        PROFILE_END();
+        PROFILE_BEGIN("update");
+        int steps = replay.StepsThisFrame(clock);
+        for (int s = 0; s < steps && !roundOver; s++) {
+            prevX = field.x;
+            input.frame = replay.NextInput(latch);
+            input.Sample(state, field, wantsMove);
+            events.clear();
+            StepRedLight(state, rules, field, wantsMove, clock.Dt(), events);
+
+            // A crowd can lose hundreds in one tick: one sound each, and only players are recorded
+            bool hit = false, won = false;
+            for (const RedLightEvent &e : events) {
+                bool player = (size_t)e.player < players.size();
+                if (e.type == EVENT_GREEN_LIGHT) PlaySound(dollPoem);
+                else if (e.type == EVENT_ELIMINATED) {
+                    hit = true;
+                    if (player) RecordResult(REPLAY_REDLIGHT, players[e.player].name.c_str(), RESULT_LOST);
+                } else if (e.type == EVENT_FINISHED) {
+                    won = true;
+                    if (player) RecordResult(REPLAY_REDLIGHT, players[e.player].name.c_str(), RESULT_WON, field.finishTime[e.player]);
+                }
+            }
+            if (hit) PlaySound(hitSound);
+            if (won) PlaySound(winSound);
+            roundOver = IsRedLightOver(state, field);
+        }
+        UpdateFieldCamera(camera);
+        PROFILE_END();
+
+        float alpha = clock.Alpha();
+        for (size_t i = 0; i < players.size(); i++) {
+            players[i].pos.x = Lerp(prevX[i], field.x[i], alpha);
+            players[i].alive = field.IsAlive(i);
+            players[i].finished = field.IsFinished(i);
+            players[i].finishTime = field.finishTime[i];
+            players[i].glowPhase = field.glowPhase[i];
         }
 
         BeginDrawing();
+        PROFILE_BEGIN("draw");
         DrawBackground();
-        DrawTextOutlined(TextFormat("Time Left: %.1f", gameTimer), SCREEN_WIDTH - 300, 50, 40, WHITE, BLACK);
 
-        Texture2D doll = (currentPhase == PHASE_GREEN) ? dollBack : dollFront;
+        // The doll watches from the screen, whatever the camera does
+        const Sprite &doll = (state.phase == PHASE_GREEN) ? dollBack : dollFront;
         float dollScale = 0.4f;
-        float dollWidth = doll.width * dollScale;
-        float dollHeight = doll.height * dollScale;
-        DrawTexturePro(doll, Rectangle{0, 0, (float)doll.width, (float)doll.height},
-                       Rectangle{SCREEN_WIDTH / 2 - dollWidth / 2, 50, dollWidth, dollHeight},
-                       Vector2{0, 0}, 0.0f, WHITE);
-
-        DrawTextOutlined(currentPhase == PHASE_GREEN ? "GREEN LIGHT" : "RED LIGHT",
-                         SCREEN_WIDTH / 2 - 150, 20, 60,
-                         currentPhase == PHASE_GREEN ? GREEN : RED, BLACK);
-        DrawLine(finishX, 0, finishX, SCREEN_HEIGHT, YELLOW);
-
+        float dollWidth = doll.Width() * dollScale;
+        float dollHeight = doll.Height() * dollScale;
+        sprites.Draw(doll, {SCREEN_WIDTH / 2 - dollWidth / 2, 50, dollWidth, dollHeight}, WHITE);
+        sprites.Flush();
+
+        // The field through the camera: the visible crowd and every player's glow and portrait
+        // come from the atlas, so they are one batch; then names, then the crowd's cached labels
+        crowd.Prepare(camera, SCREEN_WIDTH, SCREEN_HEIGHT, field, prevX.data(), alpha, crowdLayout);
+        BeginMode2D(camera);
+        float fieldBottom = std::max((float)SCREEN_HEIGHT, crowdLayout.Bottom());
+        DrawLineV({rules.finishX, 0}, {rules.finishX, fieldBottom}, YELLOW);
+        crowd.DrawWorld(sprites);
         for (auto &p : players) {
-            if (!p.alive || p.finished) continue;
-
-            if (IsKeyDown(p.moveKey)) {
-                if (currentPhase == PHASE_GREEN) {
-                    p.pos.x += 4;
-                } else {
-                    p.alive = false;
-                    PlaySound(hitSound);
-                }
-            }
-
-            if (p.pos.x >= finishX && p.alive && !p.finished) {
-                p.finished = true;
-                p.finishTime = 30.0f - gameTimer;
-                PlaySound(winSound);
-            }
-
-            DrawPlayer(p);
-            p.glowPhase += 0.05f;
+            if (!p.finished) DrawPlayer(p, sprites);
+        }
+        sprites.Flush();
+        for (auto &p : players) {
+            if (!p.finished) DrawPlayerName(p);
         }
+        EndMode2D();
+        crowd.DrawLabels(sprites);
+        sprites.Flush();
+
+        DrawTextOutlined(TextFormat("Time Left: %.1f", state.gameTimer), SCREEN_WIDTH - 300, 50, 40, WHITE, BLACK);
+        DrawTextOutlined(state.phase == PHASE_GREEN ? "GREEN LIGHT" : "RED LIGHT",
+                         SCREEN_WIDTH / 2 - 150, 20, 60,
+                         state.phase == PHASE_GREEN ? GREEN : RED, BLACK);
+        PROFILE_END();
 
+        PROFILE_FRAME();
         EndDrawing();
 
-        if (gameTimer <= 0 || AreAllPlayersDeadOrFinished()) break;
+        if (roundOver) break;
     }
 
+    // Whoever was still on the field when time ran out is out too
+    if (roundOver)
+        for (size_t i = 0; i < players.size(); i++)
+            if (field.IsAlive(i) && !field.IsFinished(i)) RecordResult(REPLAY_REDLIGHT, players[i].name.c_str(), RESULT_LOST);
+
     currentState = WINNERS;
 }
 
+void RedLightGreenLight() {
+    AcquireRedLightAssets();
+    RunRedLightGreenLight();
+    ReleaseRedLightAssets();
+}
+
 // ---------------------------
-// Dalgona (single PNG) helper + game
+// Dalgona (procedural cookie) helper + game
 // ---------------------------
 
 // Configuration (tweak these to make it easier/harder)
 const int MAX_CRACKS_ALLOWED = 30;
 const float CRACK_COOLDOWN = 0.35f; // seconds between counting cracks
-const float PROGRESS_GOAL = 0.60f;  // 60% of outline pixels
-const int OUTLINE_DARKNESS_THRESHOLD = 110; // lower -> more strict outline detection (0-255)
-const int ALLOWED_RADIUS_INSIDE = 2;  // how far inside outline we allow (in image pixels)
-const int ALLOWED_RADIUS_OUTSIDE = 2; // how far outside outline we allow (in image pixels)
-
-static inline bool IsDarkOutline(const Color &c) {
-    // Use luminance to detect dark outline pixels; require visible alpha
-    if (c.a == 0) return false;
-    float luminance = 0.2126f * c.r + 0.7152f * c.g + 0.0722f * c.b;
-    return (luminance <= OUTLINE_DARKNESS_THRESHOLD);
+const float PROGRESS_GOAL = 0.60f;  // 60% of the outline's length
+const int ALLOWED_RADIUS_INSIDE = 2;  // how far inside outline we allow (in cookie pixels)
+const int ALLOWED_RADIUS_OUTSIDE = 2; // how far outside outline we allow (in cookie pixels)
+
+// Mark the outline within tolerance radius of the stroke from (x0,y0) to (x1,y1)
+StrokeScratch ScratchStroke(int x0, int y0, int x1, int y1, const CookieOutline &cookie, CookieScratch &scratched) {
+    int r = std::max(ALLOWED_RADIUS_INSIDE, ALLOWED_RADIUS_OUTSIDE);
+    return ScratchCookieAlong(cookie, x0, y0, x1, y1, (float)r, scratched);
 }
-static inline bool IsVisibleCookiePixel(const Color &c) {
-    return (c.a > 0);
+
+void AcquireDalgonaAssets() {
+    cookieBox = assets.AcquireSprite("cookie_box.png");
+    crackSound = assets.AcquireSound("crack.mp3");
+    scratchSound = assets.AcquireSound("scratch.mp3");
 }
 
-// Check if any outline pixel exists within tolerance radius around (x,y)
-bool FindAndMarkOutlineNearby(int imgX, int imgY, int w, int h, Color *pixels,
-                              std::vector<bool> &scratchedMask, int &scratchedPixels) {
-    int r = std::max(ALLOWED_RADIUS_INSIDE, ALLOWED_RADIUS_OUTSIDE);
-    bool foundAny = false;
-
-    // We'll search in a small square and if we find outline pixels we'll mark them
-    for (int dy = -r; dy <= r; dy++) {
-        for (int dx = -r; dx <= r; dx++) {
-            int nx = imgX + dx;
-            int ny = imgY + dy;
-            if (nx < 0 || nx >= w || ny < 0 || ny >= h) continue;
-            Color c = pixels[ny * w + nx];
-            if (IsDarkOutline(c)) {
-                int idx = ny * w + nx;
-                if (!scratchedMask[idx]) {
-                    scratchedMask[idx] = true;
-                    scratchedPixels++;
-                }
-                foundAny = true;
-            }
-        }
-    }
-    return foundAny;
+void ReleaseDalgonaAssets() {
+    for (const char *file : {"cookie_box.png", "crack.mp3", "scratch.mp3"}) assets.Release(file);
 }
 
 // Main Dalgona function (replaces previous)
-void PlayDalgona() {
+void RunDalgona() {
     // UI & gameplay params
     const float revealDuration = 1.2f;
-    const float shapeScale = 1.0f;
+    const int cookieSize = (int)(std::min(SCREEN_WIDTH, SCREEN_HEIGHT) * 0.6f); // pixels, drawn 1:1
 
-    Texture2D mysteryTexture = LoadTexture("cookie_box.png"); // closed box image for selection
+    const Sprite &mysterySprite = cookieBox;
     Color mysteryTint = {255, 255, 255, 255};
 
     int selectedIndex = -1;
     int assignedShape = -1;
 
-    // Step 1: Player picks one of 4 closed cookies (instant selection)
+    // Step 1: Player picks one of 4 closed cookies (instant selection).
+    // The pick doesn't change the game, so a replay goes straight to the recorded shape.
+    if (replay.Replaying()) selectedIndex = 0;
     while (!WindowShouldClose() && selectedIndex == -1) {
         BeginDrawing();
         DrawBackground();
         DrawTextOutlined("Pick a Cookie!", SCREEN_WIDTH / 2 - 150, 50, 50, GOLD, BLACK);
 
+        // All four boxes in one sprite batch, then the hover outline on top
+        const float scale = 0.38f;
+        Rectangle boxes[4];
         for (int i = 0; i < 4; i++) {
-            float x = 240 + i * 200;
-            float y = 280;
-            float scale = 0.38f;
-
-            DrawTextureEx(mysteryTexture, {x, y}, 0.0f, scale, mysteryTint);
-
-            Rectangle rect = {x, y, mysteryTexture.width * scale, mysteryTexture.height * scale};
-            Vector2 mouse = GetMousePosition();
+            boxes[i] = {240.0f + i * 200, 280, mysterySprite.Width() * scale, mysterySprite.Height() * scale};
+            sprites.Draw(mysterySprite, boxes[i], mysteryTint);
+        }
+        sprites.Flush();
 
-            if (CheckCollisionPointRec(mouse, rect)) {
-                DrawRectangleLinesEx(rect, 5, YELLOW);
+        for (int i = 0; i < 4; i++) {
+            if (CheckCollisionPointRec(GetMousePosition(), boxes[i])) {
+                DrawRectangleLinesEx(boxes[i], 5, YELLOW);
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                     selectedIndex = i;
                 }
@@ -354,138 +581,122 @@ void PlayDalgona() {
 
         DrawTextOutlined("Click any box to choose — shape assigned randomly", SCREEN_WIDTH / 2 - 360, 380, 20, WHITE, BLACK);
         DrawTextOutlined("Press B to go back", SCREEN_WIDTH / 2 - 100, 620, 24, WHITE, BLACK);
+        PROFILE_FRAME();
+        Pacer().Idle(StaticScreenIdle()); // hover highlights follow mouse events
         EndDrawing();
 
         if (IsKeyPressed(KEY_B)) {
-            UnloadTexture(mysteryTexture);
             currentState = MENU;
             return;
         }
     }
+    Pacer().Resume();
     if (WindowShouldClose()) {
-        UnloadTexture(mysteryTexture);
         return;
     }
 
-    // Step 2: Assign random cookie shape (from the loaded dalgonaShapes textures)
-    assignedShape = rand() % 4;
-    Texture2D chosenShape = dalgonaShapes[assignedShape];
+    // Step 2: Assign random cookie shape and generate its outline and texture at display size
+    replay.BeginSegment(REPLAY_DALGONA);
+    assignedShape = (int)dalgonaRng.Range(COOKIE_SHAPE_COUNT);
+    PROFILE_BEGIN("cookie build");
+    CookieOutline cookie = BuildCookieOutline(COOKIE_SHAPES[assignedShape].make(), cookieSize);
+    Image cookieImage = GenCookieImage(cookie);
+    Texture2D chosenShape = LoadTextureFromImage(cookieImage);
+    UnloadImage(cookieImage);
+    PROFILE_END();
+    Vector2 shapePos = {(SCREEN_WIDTH - cookieSize) / 2.0f, (SCREEN_HEIGHT - cookieSize) / 2.0f};
 
     // Step 3: Reveal chosen shape briefly
-    float revealTimer = 0.0f;
-    while (!WindowShouldClose() && revealTimer < revealDuration) {
-        revealTimer += GetFrameTime();
+    FixedStepClock clock;
+    const int revealTicks = clock.TicksFor(revealDuration);
+    while (!WindowShouldClose() && clock.tick < revealTicks) {
+        replay.StepsThisFrame(clock);
         BeginDrawing();
         DrawBackground();
         DrawTextOutlined("Your Cookie Shape!", SCREEN_WIDTH / 2 - 160, 50, 50, GOLD, BLACK);
-        Vector2 shapePos = {(SCREEN_WIDTH - chosenShape.width * shapeScale) / 2,
-                            (SCREEN_HEIGHT - chosenShape.height * shapeScale) / 2};
-        DrawTextureEx(chosenShape, shapePos, 0.0f, shapeScale, WHITE);
+        DrawTextureV(chosenShape, shapePos, WHITE);
+        PROFILE_FRAME();
         EndDrawing();
     }
     if (WindowShouldClose()) {
-        UnloadTexture(mysteryTexture);
+        UnloadTexture(chosenShape);
         return;
     }
 
-    // Step 4: Prepare tracing: load image pixels from chosen texture
-    Image shapeImg = LoadImageFromTexture(chosenShape);
-    Color *pixels = LoadImageColors(shapeImg);
-    int imgW = shapeImg.width;
-    int imgH = shapeImg.height;
-
-    // Compute total outline pixels (we consider dark pixels as outline)
-    int totalOutlinePixels = 0;
-    for (int y = 0; y < imgH; y++) {
-        for (int x = 0; x < imgW; x++) {
-            if (IsDarkOutline(pixels[y * imgW + x])) totalOutlinePixels++;
-        }
-    }
-    if (totalOutlinePixels <= 0) {
-        // fallback: consider any visible pixel as outline (very permissive)
-        for (int y = 0; y < imgH; y++)
-            for (int x = 0; x < imgW; x++)
-                if (IsVisibleCookiePixel(pixels[y * imgW + x])) totalOutlinePixels++;
-    }
-
-    std::vector<bool> scratchedMask(imgW * imgH, false);
-    int scratchedPixels = 0;
+    // Step 4: Prepare tracing. Progress is the share of the outline's length scratched; the
+    // scratched stretches are also painted into a pixel mask for the overlay.
+    CookieScratch scratched(cookie.beads);
+    TiledBitset scratchedMask(cookieSize, cookieSize);
     int crackCounter = 0;
     float crackTimer = 0.0f;
     float progress = 0.0f;
 
-    // Compute on-screen position & scale for drawing the shape nicely centered (scale to fit)
-    float maxDisplayW = SCREEN_WIDTH * 0.6f;
-    float maxDisplayH = SCREEN_HEIGHT * 0.6f;
-    float scaleX = maxDisplayW / imgW;
-    float scaleY = maxDisplayH / imgH;
-    float drawScale = std::min(scaleX, scaleY);
-    if (drawScale <= 0.0f) drawScale = 1.0f;
-    Vector2 shapePos = {(SCREEN_WIDTH - imgW * drawScale) / 2.0f,
-                        (SCREEN_HEIGHT - imgH * drawScale) / 2.0f};
-
-    // Step 5: Tracing loop
+    // Scratched pixels live in a texture that is patched incrementally and drawn as one quad
+    ScratchOverlay overlay = LoadScratchOverlay(cookieSize, cookieSize, Fade(GRAY, 0.9f));
+
+    // Step 5: Tracing loop (rules run in fixed ticks on latched mouse input). Each tick scratches
+    // the whole stroke from the previous tick's mouse position, so a low frame rate (fewer,
+    // farther-apart samples) scores the same movement the same way.
+    InputLatch latch;
+    bool stroking = false;
+    int strokeX = 0, strokeY = 0;
+    clock.Reset();
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        crackTimer -= dt;
+        PROFILE_BEGIN("input");
+        latch.Poll();
+        PROFILE_END();
+        PROFILE_BEGIN("update");
+        int steps = replay.StepsThisFrame(clock);
+        for (int s = 0; s < steps; s++) {
+            InputFrame in = replay.NextInput(latch);
+            crackTimer -= clock.Dt();
+
+            Vector2 mouse = in.Mouse();
+            int imgX = (int)floorf(mouse.x - shapePos.x);
+            int imgY = (int)floorf(mouse.y - shapePos.y);
+
+            // Only active when holding mouse button. Every point of the stroke on the cookie must be
+            // near the outline within allowed radii.
+            if (in.MouseDown()) {
+                if (!stroking) {
+                    strokeX = imgX;
+                    strokeY = imgY;
+                }
+                StrokeScratch stroke = ScratchStroke(strokeX, strokeY, imgX, imgY, cookie, scratched);
+                // small feedback sound but don't spam: play when we actually scratch new pixel
+                if (stroke.hit) PlaySound(scratchSound);
+                // Straying off the outline anywhere along the stroke counts toward a crack (cooldown applies)
+                if (stroke.missed && crackTimer <= 0.0f) {
+                    crackCounter++;
+                    crackTimer = CRACK_COOLDOWN;
+                    PlaySound(crackSound);
+                }
+            }
+            stroking = in.MouseDown();
+            strokeX = imgX;
+            strokeY = imgY;
+
+            // Update progress
+            if (cookie.beads > 0) progress = (float)scratched.count / (float)cookie.beads;
+            else progress = 0.0f;
+            if (progress >= PROGRESS_GOAL || crackCounter >= MAX_CRACKS_ALLOWED) break;
+        }
+        PROFILE_END();
 
         BeginDrawing();
+        PROFILE_BEGIN("draw");
         DrawBackground();
         DrawTextOutlined("Trace the Shape Carefully! Hold mouse button while tracing", SCREEN_WIDTH / 2 - 340, 20, 22, GOLD, BLACK);
 
         // Draw cookie
-        DrawTextureEx(chosenShape, shapePos, 0.0f, drawScale, WHITE);
-
-        Vector2 mouse = GetMousePosition();
-        int imgX = (int)((mouse.x - shapePos.x) / drawScale);
-        int imgY = (int)((mouse.y - shapePos.y) / drawScale);
-
-        bool anyOutlineHitThisFrame = false;
-
-        if (imgX >= 0 && imgX < imgW && imgY >= 0 && imgY < imgH) {
-            // Only active when holding mouse button
-            if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-                // We require:
-                //  - the current point to be within the cookie (visible)
-                //  - and near an outline pixel within allowed radii
-                Color curPx = pixels[imgY * imgW + imgX];
-                bool insideCookie = IsVisibleCookiePixel(curPx);
-                if (insideCookie) {
-                    // Try to find any outline pixel nearby and mark it scratched
-                    bool found = FindAndMarkOutlineNearby(imgX, imgY, imgW, imgH, pixels, scratchedMask, scratchedPixels);
-                    if (found) {
-                        anyOutlineHitThisFrame = true;
-                        // small feedback sound but don't spam: play when we actually scratch new pixel
-                        PlaySound(scratchSound);
-                    }
-                }
-                // If we didn't hit any outline pixels near the cursor, this counts toward a crack (cooldown applies)
-                if (!anyOutlineHitThisFrame) {
-                    if (crackTimer <= 0.0f) {
-                        crackCounter++;
-                        crackTimer = CRACK_COOLDOWN;
-                        PlaySound(crackSound);
-                    }
-                }
-            }
-        }
+        DrawTextureV(chosenShape, shapePos, WHITE);
 
-        // Update progress
-        if (totalOutlinePixels > 0) progress = (float)scratchedPixels / (float)totalOutlinePixels;
-        else progress = 0.0f;
-
-        // Draw scratched overlay (small visualization): draw small circles on scratched outline pixels (scaled)
-        // to show progress to player (optional). Keep it light-weight by sampling.
-        for (int y = 0; y < imgH; y++) {
-            for (int x = 0; x < imgW; x++) {
-                int idx = y * imgW + x;
-                if (scratchedMask[idx]) {
-                    Vector2 drawAt = { shapePos.x + x * drawScale, shapePos.y + y * drawScale };
-                    // small dot
-                    DrawCircleV(drawAt, std::max(1.0f, drawScale * 0.6f), Fade(GRAY, 0.9f));
-                }
-            }
-        }
+        // Draw scratched overlay: upload only what changed this frame, then a single textured draw
+        PROFILE_BEGIN("scratch upload");
+        StampCookieScratches(cookie, scratched, scratchedMask);
+        FlushScratchOverlay(overlay, scratchedMask);
+        PROFILE_END();
+        DrawScratchOverlay(overlay, shapePos, 1.0f);
 
         // Progress bar
         int barX = 200;
@@ -500,70 +711,98 @@ void PlayDalgona() {
                          barX + 10, barY - 28, 20, WHITE, BLACK);
         DrawTextOutlined(TextFormat("Cracks: %d / %d", crackCounter, MAX_CRACKS_ALLOWED),
                          barX + barW - 200, barY - 28, 20, RED, BLACK);
+        PROFILE_END();
 
+        PROFILE_FRAME();
         EndDrawing();
 
         // Win / lose conditions
         if (progress >= PROGRESS_GOAL) {
             // success - mark winners state
-            UnloadImageColors(pixels);
-            UnloadImage(shapeImg);
-            UnloadTexture(mysteryTexture);
+            RecordResult(REPLAY_DALGONA, players[0].name.c_str(), RESULT_WON);
+            UnloadScratchOverlay(overlay);
+            UnloadTexture(chosenShape);
             currentState = WINNERS;
             return;
         }
         if (crackCounter >= MAX_CRACKS_ALLOWED) {
             // failed - go to winners state as "failed" (you can change to GAMEOVER or specific screen)
-            UnloadImageColors(pixels);
-            UnloadImage(shapeImg);
-            UnloadTexture(mysteryTexture);
+            RecordResult(REPLAY_DALGONA, players[0].name.c_str(), RESULT_LOST);
+            UnloadScratchOverlay(overlay);
+            UnloadTexture(chosenShape);
             currentState = WINNERS;
             return;
         }
     }
 
     // Fallback cleanup
-    UnloadImageColors(pixels);
-    UnloadImage(shapeImg);
-    UnloadTexture(mysteryTexture);
+    UnloadScratchOverlay(overlay);
+    UnloadTexture(chosenShape);
+}
+
+void PlayDalgona() {
+    AcquireDalgonaAssets();
+    RunDalgona();
+    ReleaseDalgonaAssets();
+}
+
+// ---------------------------
+// Hosted scenes
+// ---------------------------
+
+void PlayScene(Scene &scene, SceneStatus &status) {
+    if (status == SCENE_UNLOADED) status = scene.Init(sceneCtx) ? SCENE_READY : SCENE_FAILED;
+    if (status == SCENE_READY) RunScene(scene, replay, KEY_B, "B: back to menu");
+    currentState = MENU;
+}
+
+void ShutdownHub() {
+    if (ropeStatus == SCENE_READY) ropeScene.Shutdown();
+    if (bridgeStatus == SCENE_READY) bridgeScene.Shutdown();
+    if (marbleStatus == SCENE_READY) marbleScene.Shutdown();
+    assets.UnloadAll();
+    UnloadScreens();
+    outlinedText.Unload();
+    PROFILE_FINISH();
 }
 
 // ---------------------------
 // Main
 // ---------------------------
-int main() {
+int main(int argc, char **argv) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Super Squid Tournament");
     InitAudioDevice();
     SetTargetFPS(60);
-    srand((unsigned int)time(nullptr));
-
-    // Load assets
-    hitSound = LoadSound("hit.mp3");
-    winSound = LoadSound("win.mp3");
-    dollPoem = LoadSound("poem.mp3");
-
-    dollFront = LoadTexture("doll_front.png");
-    dollBack = LoadTexture("doll_back.png");
-
-    Wave poemWave = LoadWave("poem.mp3");
-    greenDuration = (float)poemWave.frameCount / poemWave.sampleRate;
-    UnloadWave(poemWave);
-
-    playerTextures.push_back(LoadTexture("456.png"));
-    playerTextures.push_back(LoadTexture("222.png"));
-    playerTextures.push_back(LoadTexture("333.png"));
-    playerTextures.push_back(LoadTexture("388.png"));
-
-    // Your cookie PNGs (the actual cookie image for each shape)
-    dalgonaShapes[0] = LoadTexture("circle.png");
-    dalgonaShapes[1] = LoadTexture("triangle.png");
-    dalgonaShapes[2] = LoadTexture("umbrella.png");
-    dalgonaShapes[3] = LoadTexture("star.png");
-
-    crackSound = LoadSound("crack.mp3");
-    scratchSound = LoadSound("scratch.mp3");
+    runSeed = replay.Start(argc, argv, REPLAY_HUB);
+    PROFILE_START(argc, argv);
+    Pacer().Start(argc, argv);
+    dalgonaRng.Seed(runSeed, STREAM_DALGONA);
+
+    // Start decoding everything in the background; the menu needs none of it
+    if (bundle.Open(BUNDLE_DEFAULT_PATH)) assets.SetBundle(&bundle);
+    assets.PreloadAtlas(ATLAS_FILES);
+    Image glow = GenImageColor(2 * PLAYER_GLOW_RADIUS + 1, 2 * PLAYER_GLOW_RADIUS + 1, BLANK);
+    ImageDrawCircle(&glow, PLAYER_GLOW_RADIUS, PLAYER_GLOW_RADIUS, PLAYER_GLOW_RADIUS, WHITE);
+    assets.AddToAtlas(PLAYER_GLOW_SPRITE, glow);
+    UnloadImage(glow);
+    Image dot = GenImageColor(4, 4, WHITE);
+    assets.AddToAtlas(CROWD_DOT_SPRITE, dot);
+    UnloadImage(dot);
+    for (const char *file : PRELOAD_SOUNDS) assets.PreloadSound(file);
 
     gameFont = GetFontDefault();
+    outlinedText.Load(gameFont);
+    LoadScreens();
+
+    sceneCtx.width = SCREEN_WIDTH;
+    sceneCtx.height = SCREEN_HEIGHT;
+    sceneCtx.seed = runSeed;
+    sceneCtx.assets = &assets;
+    // A replayed hub run doesn't record, not even the live rounds after it hands over
+    if (!replay.Replaying() && tournament.Open(ResultsPath(argc, argv))) sceneCtx.results = &tournament;
+    marbleScene.UseStrategy(replay.Setting("marble-ai", MarbleStrategyName(argc, argv), MARBLE_LEGACY_STRATEGY).c_str());
+    // The bots follow the run seed, so the crowd's size is all a replay needs to play it again
+    crowdSize = std::max(atoi(replay.Setting("crowd", std::to_string(CrowdSize(argc, argv)), "0").c_str()), 0);
 
     players = {
         {"456", BLUE, {80, 200}, KEY_RIGHT, true, false, 0, -1, 0.f, 0},
@@ -571,31 +810,42 @@ int main() {
         {"333", GREEN,{80, 400}, KEY_E,     true, false, 0, -1, 0.f, 2},
         {"388", GOLD, {80, 500}, KEY_S,     true, false, 0, -1, 0.f, 3}
     };
+    // The scenes play one contestant (two in tug of war, matching its portraits)
+    sceneCtx.playerName = players[0].name;
+    sceneCtx.rivalName = players[2].name;
 
     while (!WindowShouldClose()) {
+        // A replay plays its recorded mini-games back to back, skipping the menus in between
+        if (replay.Replaying() && (currentState == MENU || currentState == WINNERS)) {
+            int segment = replay.PeekSegment();
+            if (segment == REPLAY_REDLIGHT) currentState = REDLIGHT;
+            else if (segment == REPLAY_DALGONA) currentState = DALGONA;
+            else if (segment == REPLAY_ROPE) currentState = ROPE;
+            else if (segment == REPLAY_BRIDGE) currentState = BRIDGE;
+            else if (segment == REPLAY_MARBLE) currentState = MARBLE;
+        }
+        Pacer().Resume(); // only the static screens below ask to idle, one frame at a time
         switch (currentState) {
         case MENU: ShowMenu(); break;
         case CONTROLS: ShowControls(); break;
         case REDLIGHT: RedLightGreenLight(); break;
         case DALGONA: PlayDalgona(); break;
+        case ROPE: PlayScene(ropeScene, ropeStatus); break;
+        case BRIDGE: PlayScene(bridgeScene, bridgeStatus); break;
+        case MARBLE: PlayScene(marbleScene, marbleStatus); break;
         case WINNERS: ShowWinners(); break;
         case GAMEOVER:
+            ShutdownHub();
             CloseWindow();
             return 0;
         }
+        PROFILE_BEGIN("asset poll");
+        assets.Poll();
+        PROFILE_END();
     }
 
     // Cleanup
-    UnloadSound(hitSound);
-    UnloadSound(winSound);
-    UnloadSound(dollPoem);
-    UnloadTexture(dollFront);
-    UnloadTexture(dollBack);
-    for (auto &tex : playerTextures) UnloadTexture(tex);
-    for (int i = 0; i < 4; ++i) UnloadTexture(dalgonaShapes[i]);
-    UnloadSound(crackSound);
-    UnloadSound(scratchSound);
-
+    ShutdownHub();
     CloseAudioDevice();
     CloseWindow();
     return 0;
@@ -0,0 +1,88 @@
+// Tick scheduler
+// A small persistent thread pool for splitting one simulation tick into independent chunks.
+// The calling thread works on chunks too and ParallelFor returns only when every chunk is
+// done, so callers can merge per-chunk results in a fixed order afterwards.
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+class TickScheduler {
+public:
+    // threadCount <= 0 uses one thread per hardware core (including the caller)
+    explicit TickScheduler(int threadCount = 0) {
+        if (threadCount <= 0) threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 1; i < threadCount; i++) workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~TickScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t : workers) t.join();
+    }
+
+    TickScheduler(const TickScheduler &) = delete;
+    TickScheduler &operator=(const TickScheduler &) = delete;
+
+    int ThreadCount() const { return (int)workers.size() + 1; }
+
+    // Run fn(chunk) for chunk in [0, chunkCount); chunks are claimed dynamically by all threads
+    void ParallelFor(int chunkCount, const std::function<void(int)> &fn) {
+        if (workers.empty() || chunkCount <= 1) {
+            for (int c = 0; c < chunkCount; c++) fn(c);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &fn;
+            chunks = chunkCount;
+            nextChunk.store(0);
+            pending = (int)workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        RunChunks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        task = nullptr;
+    }
+
+private:
+    void RunChunks() {
+        for (int c = nextChunk.fetch_add(1); c < chunks; c = nextChunk.fetch_add(1)) (*task)(c);
+    }
+
+    void WorkerLoop() {
+        unsigned long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            RunChunks();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)> *task = nullptr;
+    std::atomic<int> nextChunk{0};
+    int chunks = 0;
+    int pending = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,139 @@
+// Tiled bitset
+// One bit per pixel, packed as 8x8 tiles into 64-bit words so that a small square of
+// pixels sits in one or a few cache lines. Keeps a running popcount for progress and a
+// per-tile dirty bit so renderers only revisit tiles that changed.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline int PopCount64(uint64_t v) { return (int)__popcnt64(v); }
+static inline int CountTrailingZeros64(uint64_t v) { unsigned long i; _BitScanForward64(&i, v); return (int)i; }
+#else
+static inline int PopCount64(uint64_t v) { return __builtin_popcountll(v); }
+static inline int CountTrailingZeros64(uint64_t v) { return __builtin_ctzll(v); }
+#endif
+
+const int TILE_SIZE = 8; // tiles are 8x8 pixels, one uint64_t each
+
+struct TiledBitset {
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    int count = 0;                  // number of set bits, kept up to date by Set/SetTileBits
+    std::vector<uint64_t> tiles;    // bit (y%8)*8 + (x%8) of tile (y/8)*tilesX + (x/8)
+    std::vector<uint64_t> dirty;    // one bit per tile, set whenever the tile gains bits
+
+    TiledBitset() = default;
+    TiledBitset(int w, int h) { Resize(w, h); }
+
+    void Resize(int w, int h) {
+        width = w;
+        height = h;
+        tilesX = (w + TILE_SIZE - 1) / TILE_SIZE;
+        tilesY = (h + TILE_SIZE - 1) / TILE_SIZE;
+        tiles.assign((size_t)tilesX * tilesY, 0);
+        dirty.assign((tiles.size() + 63) / 64, 0);
+        count = 0;
+    }
+
+    void Clear() {
+        std::fill(tiles.begin(), tiles.end(), 0);
+        std::fill(dirty.begin(), dirty.end(), 0);
+        count = 0;
+    }
+
+    int TileIndex(int x, int y) const { return (y / TILE_SIZE) * tilesX + (x / TILE_SIZE); }
+    static uint64_t BitOf(int x, int y) { return 1ULL << ((y % TILE_SIZE) * TILE_SIZE + (x % TILE_SIZE)); }
+
+    bool Test(int x, int y) const { return tiles[TileIndex(x, y)] & BitOf(x, y); }
+
+    // Returns true if the bit was newly set
+    bool Set(int x, int y) {
+        return SetTileBits(TileIndex(x, y), BitOf(x, y)) != 0;
+    }
+
+    // OR bits into one tile; returns how many of them were newly set
+    int SetTileBits(int tile, uint64_t bits) {
+        uint64_t added = bits & ~tiles[tile];
+        if (!added) return 0;
+        tiles[tile] |= added;
+        dirty[tile / 64] |= 1ULL << (tile % 64);
+        int n = PopCount64(added);
+        count += n;
+        return n;
+    }
+
+    // Recount from scratch (used after bulk writes to tiles[])
+    int Recount() {
+        count = 0;
+        for (uint64_t t : tiles) count += PopCount64(t);
+        return count;
+    }
+
+    // Mask of the pixels of tile (tx,ty) that fall inside the inclusive region [x0,x1]x[y0,y1]
+    static uint64_t RegionMask(int tx, int ty, int x0, int y0, int x1, int y1) {
+        int ax = std::max(x0 - tx * TILE_SIZE, 0), bx = std::min(x1 - tx * TILE_SIZE, TILE_SIZE - 1);
+        int ay = std::max(y0 - ty * TILE_SIZE, 0), by = std::min(y1 - ty * TILE_SIZE, TILE_SIZE - 1);
+        if (ax > bx || ay > by) return 0;
+        uint64_t row = (0xFFULL >> (TILE_SIZE - 1 - (bx - ax))) << ax;
+        uint64_t mask = 0;
+        for (int y = ay; y <= by; y++) mask |= row << (y * TILE_SIZE);
+        return mask;
+    }
+
+    // Calls fn(tileIndex, regionMask) for every tile overlapping the inclusive region (clipped)
+    template <typename Fn>
+    void ForEachTileInRegion(int x0, int y0, int x1, int y1, Fn fn) const {
+        x0 = std::max(x0, 0); y0 = std::max(y0, 0);
+        x1 = std::min(x1, width - 1); y1 = std::min(y1, height - 1);
+        if (x0 > x1 || y0 > y1) return;
+        for (int ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++)
+            for (int tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++)
+                fn(ty * tilesX + tx, RegionMask(tx, ty, x0, y0, x1, y1));
+    }
+
+    // True when every pixel of the inclusive region is set
+    bool AllSetInRegion(int x0, int y0, int x1, int y1) const {
+        bool all = true;
+        ForEachTileInRegion(x0, y0, x1, y1, [&](int tile, uint64_t mask) {
+            if ((tiles[tile] & mask) != mask) all = false;
+        });
+        return all;
+    }
+
+    // True when every pixel that is set in `required` is also set here, within the region
+    bool AllSetInRegion(int x0, int y0, int x1, int y1, const TiledBitset &required) const {
+        bool all = true;
+        ForEachTileInRegion(x0, y0, x1, y1, [&](int tile, uint64_t mask) {
+            uint64_t need = required.tiles[tile] & mask;
+            if ((tiles[tile] & need) != need) all = false;
+        });
+        return all;
+    }
+
+    int CountInRegion(int x0, int y0, int x1, int y1) const {
+        int n = 0;
+        ForEachTileInRegion(x0, y0, x1, y1, [&](int tile, uint64_t mask) {
+            n += PopCount64(tiles[tile] & mask);
+        });
+        return n;
+    }
+
+    // Visit and clear the dirty tiles: fn(tileIndex)
+    template <typename Fn>
+    void ConsumeDirtyTiles(Fn fn) {
+        for (size_t w = 0; w < dirty.size(); w++) {
+            uint64_t bits = dirty[w];
+            while (bits) {
+                int b = CountTrailingZeros64(bits);
+                bits &= bits - 1;
+                fn((int)(w * 64 + b));
+            }
+            dirty[w] = 0;
+        }
+    }
+};
@@ -0,0 +1,217 @@
+// Tournament results
+// Every round's outcome from every mini-game, in the hub or a standalone program, is appended
+// to one log file (tournament.sqtr next to the executables) and folded into per-contestant
+// standings. The standings stay ordered as results arrive (one erase + insert per result), so
+// showing the top of the table never sorts, and Version() tells a screen when to relabel.
+//
+// File layout: a 16-byte header ("SQTR", u16 version, u16 record size, 8 reserved bytes), then
+// fixed 24-byte ResultRecords. The file is only ever opened for append, so several programs can
+// share it; an all-zero record is padding and is skipped.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mapped_file.h"
+#include "replay.h"
+
+const char *const RESULTS_DEFAULT_PATH = "tournament.sqtr";
+const char *const RESULTS_DEFAULT_PLAYER = "456"; // single-player games record under this number
+const char *const RESULTS_DEFAULT_RIVAL = "333";  // ... and tug of war's second player under this
+const uint16_t RESULTS_VERSION = 1;
+const size_t RESULTS_HEADER_BYTES = 16;
+const int RESULTS_NAME_BYTES = 16; // names are truncated to 15 characters
+
+enum ResultOutcome : uint8_t {
+    RESULT_NONE,    // padding
+    RESULT_WON,     // won the round, crossed the line or survived it
+    RESULT_LOST     // eliminated or beaten
+};
+
+struct ResultRecord {
+    uint8_t game;     // ReplayGame of the mini-game
+    uint8_t outcome;  // ResultOutcome
+    uint16_t reserved;
+    float time;       // seconds to finish for timed wins, -1 otherwise
+    char name[RESULTS_NAME_BYTES];
+};
+
+static_assert(sizeof(ResultRecord) == 24, "result record layout");
+
+struct Standing {
+    std::string name;
+    int wins = 0;
+    int losses = 0;
+    float bestTime = -1.0f; // fastest timed win, -1 if none
+};
+
+class TournamentResults {
+public:
+    ~TournamentResults() { Close(); }
+
+    // Loads the log and keeps it open for appending. Returns false (and records nothing) if
+    // the file can't be written or belongs to another version.
+    bool Open(const char *path) {
+        Close();
+        standings.clear();
+        ids.clear();
+        order.clear();
+        rounds = 0;
+        version++;
+        MappedReadFile existing;
+        size_t size = 0;
+        if (existing.Open(path)) {
+            size = existing.Size();
+            if (size > 0 && !Load(existing.Data(), size)) {
+                printf("Not recording results: %s is not a results log of this version\n", path);
+                return false;
+            }
+            existing.Close();
+        }
+        file = fopen(path, "ab");
+        if (!file) {
+            printf("Cannot record results to %s\n", path);
+            return false;
+        }
+        if (size < RESULTS_HEADER_BYTES) {
+            // New file, or a header cut short by a crash: write the rest of it
+            fwrite(Header() + size, 1, RESULTS_HEADER_BYTES - size, file);
+        } else if ((size - RESULTS_HEADER_BYTES) % sizeof(ResultRecord)) {
+            // Pad a torn record with zeros so new records stay aligned
+            static const uint8_t zeros[sizeof(ResultRecord)] = {};
+            fwrite(zeros, 1, sizeof(ResultRecord) - (size - RESULTS_HEADER_BYTES) % sizeof(ResultRecord), file);
+        }
+        fflush(file);
+        return true;
+    }
+
+    void Close() {
+        if (file) fclose(file);
+        file = nullptr;
+    }
+
+    bool IsOpen() const { return file != nullptr; }
+
+    // Appends one result and updates the standings
+    void Record(ReplayGame game, const char *name, ResultOutcome outcome, float time = -1.0f) {
+        ResultRecord r = {};
+        r.game = game;
+        r.outcome = outcome;
+        r.time = outcome == RESULT_WON ? time : -1.0f;
+        strncpy(r.name, name, RESULTS_NAME_BYTES - 1);
+        Apply(r);
+        if (file) {
+            fwrite(&r, sizeof(r), 1, file);
+            fflush(file); // whole records only, even if the program is killed
+        }
+    }
+
+    // Bumped by every result
+    uint64_t Version() const { return version; }
+    size_t Rounds() const { return rounds; }
+    size_t Contestants() const { return standings.size(); }
+
+    // The best n contestants, best first
+    std::vector<const Standing *> Top(size_t n) const {
+        std::vector<const Standing *> top;
+        for (auto it = order.begin(); it != order.end() && top.size() < n; ++it) top.push_back(&standings[it->id]);
+        return top;
+    }
+
+    // Null if the name has no results yet
+    const Standing *Find(const char *name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? nullptr : &standings[it->second];
+    }
+
+private:
+    // Ordering key: more wins, then fewer losses, then the fastest time (none last), then
+    // first seen
+    struct RankKey {
+        int wins;
+        int losses;
+        float bestTime;
+        uint32_t id;
+
+        bool operator<(const RankKey &o) const {
+            if (wins != o.wins) return wins > o.wins;
+            if (losses != o.losses) return losses < o.losses;
+            if (bestTime != o.bestTime) {
+                if (bestTime < 0 || o.bestTime < 0) return bestTime >= 0;
+                return bestTime < o.bestTime;
+            }
+            return id < o.id;
+        }
+    };
+
+    static RankKey KeyOf(const Standing &s, uint32_t id) { return {s.wins, s.losses, s.bestTime, id}; }
+
+    static const uint8_t *Header() {
+        static const uint8_t header[RESULTS_HEADER_BYTES] = {
+            'S', 'Q', 'T', 'R', (uint8_t)(RESULTS_VERSION & 0xFF), (uint8_t)(RESULTS_VERSION >> 8),
+            (uint8_t)sizeof(ResultRecord), 0};
+        return header;
+    }
+
+    bool Load(const uint8_t *data, size_t size) {
+        if (memcmp(data, Header(), std::min(size, (size_t)8)) != 0) return false;
+        if (size < RESULTS_HEADER_BYTES) return true;
+
+        // Fold every record first and order the contestants once at the end
+        loading = true;
+        for (size_t pos = RESULTS_HEADER_BYTES; pos + sizeof(ResultRecord) <= size; pos += sizeof(ResultRecord)) {
+            ResultRecord r;
+            memcpy(&r, data + pos, sizeof(r));
+            r.name[RESULTS_NAME_BYTES - 1] = '\0';
+            if (r.outcome == RESULT_WON || r.outcome == RESULT_LOST) Apply(r);
+        }
+        loading = false;
+        order.clear();
+        for (uint32_t id = 0; id < standings.size(); id++) order.insert(KeyOf(standings[id], id));
+        return true;
+    }
+
+    void Apply(const ResultRecord &r) {
+        auto found = ids.find(r.name);
+        uint32_t id;
+        if (found == ids.end()) {
+            id = (uint32_t)standings.size();
+            ids.emplace(r.name, id);
+            standings.emplace_back();
+            standings.back().name = r.name;
+        } else {
+            id = found->second;
+            if (!loading) order.erase(KeyOf(standings[id], id));
+        }
+
+        Standing &s = standings[id];
+        if (r.outcome == RESULT_WON) {
+            s.wins++;
+            if (r.time >= 0 && (s.bestTime < 0 || r.time < s.bestTime)) s.bestTime = r.time;
+        } else {
+            s.losses++;
+        }
+        if (!loading) order.insert(KeyOf(s, id));
+        rounds++;
+        version++;
+    }
+
+    FILE *file = nullptr;
+    std::vector<Standing> standings;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::set<RankKey> order;
+    size_t rounds = 0;
+    uint64_t version = 0;
+    bool loading = false;
+};
+
+// --results FILE picks another log than RESULTS_DEFAULT_PATH
+static inline const char *ResultsPath(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (!strcmp(argv[i], "--results")) return argv[i + 1];
+    return RESULTS_DEFAULT_PATH;
+}
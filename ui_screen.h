@@ -0,0 +1,132 @@
+// Retained UI screens
+// A static screen (menu, controls, winners) is kept as a list of labels over a background and
+// rendered into a RenderTexture. Changing a label only marks its old and new rectangles dirty;
+// the next Draw() repaints just that region (scissored background plus the labels that touch
+// it) and every frame in between costs one full-screen quad.
+#pragma once
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "frame_profiler.h"
+
+typedef void (*UiBackgroundFn)();
+typedef void (*UiTextFn)(const char *text, int x, int y, int fontSize, Color textColor, Color outlineColor);
+
+struct UiLabel {
+    std::string text;
+    int x = 0, y = 0;
+    int fontSize = 20;
+    Color color = WHITE;
+    Color outline = BLACK;
+    Rectangle bounds = {}; // area the label paints, outline included
+};
+
+class UiScreen {
+public:
+    // After InitWindow(). outline is how far drawText paints outside MeasureText's box.
+    void Load(int width, int height, UiBackgroundFn drawBackground, UiTextFn drawText, int outline = 2) {
+        target = LoadRenderTexture(width, height);
+        background = drawBackground;
+        text = drawText;
+        outlineWidth = outline;
+        Invalidate();
+    }
+
+    void Unload() {
+        if (target.id != 0) UnloadRenderTexture(target);
+        target = {};
+        labels.clear();
+    }
+
+    int AddLabel(const std::string &str, int x, int y, int fontSize, Color color, Color outline = BLACK) {
+        UiLabel label;
+        label.text = str;
+        label.x = x;
+        label.y = y;
+        label.fontSize = fontSize;
+        label.color = color;
+        label.outline = outline;
+        label.bounds = Bounds(label);
+        labels.push_back(label);
+        MarkDirty(label.bounds);
+        return (int)labels.size() - 1;
+    }
+
+    // Repaints only if the text or colour actually changed
+    void SetLabel(int id, const std::string &str, Color color) {
+        UiLabel &label = labels[id];
+        if (label.text == str && ColorToInt(label.color) == ColorToInt(color)) return;
+        MarkDirty(label.bounds);
+        label.text = str;
+        label.color = color;
+        label.bounds = Bounds(label);
+        MarkDirty(label.bounds);
+    }
+
+    void Invalidate() { MarkDirty({0, 0, (float)target.texture.width, (float)target.texture.height}); }
+    bool IsDirty() const { return dirty; }
+
+    // Inside BeginDrawing(): bring the cached image up to date and put it on screen
+    void Draw() {
+        if (dirty) Repaint();
+        // The cached image is opaque, so copy it instead of blending (blending would also
+        // have mixed its alpha into the framebuffer's)
+        rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM);
+        DrawTextureRec(target.texture, {0, 0, (float)target.texture.width, -(float)target.texture.height}, {0, 0},
+                       WHITE);
+        EndBlendMode();
+    }
+
+private:
+    Rectangle Bounds(const UiLabel &label) const {
+        float w = (float)MeasureText(label.text.c_str(), label.fontSize);
+        return {(float)(label.x - outlineWidth), (float)(label.y - outlineWidth), w + 2 * outlineWidth,
+                (float)(label.fontSize + 2 * outlineWidth)};
+    }
+
+    void MarkDirty(Rectangle r) {
+        if (r.width <= 0 || r.height <= 0) return;
+        if (!dirty) {
+            dirtyRect = r;
+            dirty = true;
+            return;
+        }
+        float x0 = std::min(dirtyRect.x, r.x), y0 = std::min(dirtyRect.y, r.y);
+        float x1 = std::max(dirtyRect.x + dirtyRect.width, r.x + r.width);
+        float y1 = std::max(dirtyRect.y + dirtyRect.height, r.y + r.height);
+        dirtyRect = {x0, y0, x1 - x0, y1 - y0};
+    }
+
+    void Repaint() {
+        int x0 = std::max(0, (int)dirtyRect.x), y0 = std::max(0, (int)dirtyRect.y);
+        int x1 = std::min(target.texture.width, (int)ceilf(dirtyRect.x + dirtyRect.width));
+        int y1 = std::min(target.texture.height, (int)ceilf(dirtyRect.y + dirtyRect.height));
+        dirty = false;
+        if (x1 <= x0 || y1 <= y0) return;
+
+        int repainted = 0;
+        BeginTextureMode(target);
+        BeginScissorMode(x0, y0, x1 - x0, y1 - y0);
+        if (background) background();
+        for (const UiLabel &label : labels) {
+            if (label.text.empty() || !CheckCollisionRecs(label.bounds, dirtyRect)) continue;
+            text(label.text.c_str(), label.x, label.y, label.fontSize, label.color, label.outline);
+            repainted++;
+        }
+        EndScissorMode();
+        EndTextureMode();
+        PROFILE_COUNT("ui labels repainted", repainted);
+    }
+
+    RenderTexture2D target = {};
+    UiBackgroundFn background = nullptr;
+    UiTextFn text = nullptr;
+    int outlineWidth = 2;
+    std::vector<UiLabel> labels;
+    bool dirty = false;
+    Rectangle dirtyRect = {};
+};